@@ -35,6 +35,7 @@
  */
 
 #include <stdio.h>
+#include <string.h>
 #include <unistd.h>
 
 #include <esp_log.h>
@@ -50,6 +51,223 @@
 
 #define CLI_LOG_TAG "OT_CLI"
 
+static otInstance *sInstance = NULL;
+
+static void printUartStats(const char *aName, const otSysUartStats *aStats)
+{
+    otCliOutputFormat("%s uart:\r\n", aName);
+    otCliOutputFormat("  fifo overflows: %u\r\n", aStats->mFifoOverflows);
+    otCliOutputFormat("  buffer full: %u\r\n", aStats->mBufferFullEvents);
+    otCliOutputFormat("  frame errors: %u\r\n", aStats->mFrameErrors);
+    otCliOutputFormat("  hdlc resyncs: %u\r\n", aStats->mHdlcResyncs);
+    otCliOutputFormat("  rx buffer: %u/%u\r\n", aStats->mRxBufferHighWater, aStats->mRxBufferSize);
+}
+
+static void processRcpLink(int argc, char *argv[])
+{
+    otSysRcpLinkStats linkStats;
+    otSysUartStats    uartStats;
+
+    if (argc > 0 && strcmp(argv[0], "reset") == 0)
+    {
+        otSysResetRcpLinkStats(sInstance);
+        otSysResetUartStats(sInstance);
+        otCliAppendResult(OT_ERROR_NONE);
+        return;
+    }
+
+    otSysGetRcpLinkStats(sInstance, &linkStats);
+
+    otCliOutputFormat("tx frames: %u\r\n", linkStats.mTxFrames);
+    otCliOutputFormat("tx bytes: %u\r\n", linkStats.mTxBytes);
+    otCliOutputFormat("rx frames: %u\r\n", linkStats.mRxFrames);
+    otCliOutputFormat("rx bytes: %u\r\n", linkStats.mRxBytes);
+    otCliOutputFormat("fcs errors: %u\r\n", linkStats.mFcsErrors);
+    otCliOutputFormat("dropped frames: %u\r\n", linkStats.mDroppedFrames);
+    otCliOutputFormat("write timeouts: %u\r\n", linkStats.mWriteTimeouts);
+    otCliOutputFormat("write blocked: %u ms\r\n", (uint32_t)(linkStats.mWriteBlockedTime / 1000));
+    otCliOutputFormat("clock drift: %d ppb\r\n", otSysGetRcpClockDrift(sInstance));
+    otCliOutputFormat("response latency:\r\n");
+
+    for (int i = 0; i < OT_SYS_RCP_LATENCY_BUCKETS; i++)
+    {
+        if (i == 0)
+        {
+            otCliOutputFormat("  < 1 ms: %u\r\n", linkStats.mLatencyHistogram[i]);
+        }
+        else if (i < OT_SYS_RCP_LATENCY_BUCKETS - 1)
+        {
+            otCliOutputFormat("  < %u ms: %u\r\n", 1U << i, linkStats.mLatencyHistogram[i]);
+        }
+        else
+        {
+            otCliOutputFormat("  >= %u ms: %u\r\n", 1U << (i - 1), linkStats.mLatencyHistogram[i]);
+        }
+    }
+
+    otSysGetRadioUartStats(sInstance, &uartStats);
+    printUartStats("radio", &uartStats);
+    otSysGetCliUartStats(sInstance, &uartStats);
+    printUartStats("cli", &uartStats);
+
+    otCliAppendResult(OT_ERROR_NONE);
+}
+
+static void processAlarm(int argc, char *argv[])
+{
+    otSysAlarmStats stats;
+
+    if (argc > 0 && strcmp(argv[0], "reset") == 0)
+    {
+        otSysResetAlarmMicroStats(sInstance);
+        otCliAppendResult(OT_ERROR_NONE);
+        return;
+    }
+
+    otSysGetAlarmMicroStats(sInstance, &stats);
+
+    otCliOutputFormat("us alarm fired: %u\r\n", stats.mFired);
+    otCliOutputFormat("max lateness: %u us\r\n", stats.mMaxLateness);
+    otCliOutputFormat("lateness:\r\n");
+
+    for (int i = 0; i < OT_SYS_ALARM_LATENESS_BUCKETS; i++)
+    {
+        if (i == 0)
+        {
+            otCliOutputFormat("  < 1 us: %u\r\n", stats.mLatenessHistogram[i]);
+        }
+        else if (i < OT_SYS_ALARM_LATENESS_BUCKETS - 1)
+        {
+            otCliOutputFormat("  < %u us: %u\r\n", 1U << i, stats.mLatenessHistogram[i]);
+        }
+        else
+        {
+            otCliOutputFormat("  >= %u us: %u\r\n", 1U << (i - 1), stats.mLatenessHistogram[i]);
+        }
+    }
+
+    otCliAppendResult(OT_ERROR_NONE);
+}
+
+static void processApiLock(int argc, char *argv[])
+{
+    otSysApiLockStats stats;
+
+    if (argc > 0 && strcmp(argv[0], "reset") == 0)
+    {
+        otSysResetApiLockStats();
+        otCliAppendResult(OT_ERROR_NONE);
+        return;
+    }
+
+    otSysGetApiLockStats(&stats);
+
+    otCliOutputFormat("acquisitions: %u\r\n", stats.mAcquisitions);
+    otCliOutputFormat("contentions: %u\r\n", stats.mContentions);
+    otCliOutputFormat("max wait: %u us\r\n", stats.mMaxWaitTime);
+    otCliOutputFormat("max hold: %u us by %s from %p\r\n", stats.mMaxHoldTime, stats.mMaxHoldTask,
+                      stats.mMaxHoldCaller);
+    otCliOutputFormat("wait/hold:\r\n");
+
+    for (int i = 0; i < OT_SYS_API_LOCK_BUCKETS; i++)
+    {
+        if (i == 0)
+        {
+            otCliOutputFormat("  < 1 us: %u/%u\r\n", stats.mWaitHistogram[i], stats.mHoldHistogram[i]);
+        }
+        else if (i < OT_SYS_API_LOCK_BUCKETS - 1)
+        {
+            otCliOutputFormat("  < %u us: %u/%u\r\n", 1U << i, stats.mWaitHistogram[i], stats.mHoldHistogram[i]);
+        }
+        else
+        {
+            otCliOutputFormat("  >= %u us: %u/%u\r\n", 1U << (i - 1), stats.mWaitHistogram[i], stats.mHoldHistogram[i]);
+        }
+    }
+
+    otCliAppendResult(OT_ERROR_NONE);
+}
+
+static void processPower(int argc, char *argv[])
+{
+    otSysPowerStats stats;
+    uint64_t        interval;
+
+    if (argc > 0 && strcmp(argv[0], "reset") == 0)
+    {
+        otSysResetPowerStats();
+        otCliAppendResult(OT_ERROR_NONE);
+        return;
+    }
+
+    otSysGetPowerStats(&stats);
+    interval = stats.mIntervalTime > 0 ? stats.mIntervalTime : 1;
+
+    otCliOutputFormat("interval: %u ms\r\n", (uint32_t)(stats.mIntervalTime / 1000));
+    otCliOutputFormat("low power: %u ms\r\n", (uint32_t)(stats.mLowPowerTime / 1000));
+    otCliOutputFormat("idle: %u ms (%u%%)\r\n", (uint32_t)(stats.mIdleTime / 1000),
+                      (uint32_t)(stats.mIdleTime * 100 / interval));
+    otCliOutputFormat("busy: %u ms\r\n", (uint32_t)((stats.mIntervalTime - stats.mIdleTime) / 1000));
+    otCliOutputFormat("idle waits: %u\r\n", stats.mIdleWaits);
+
+    otCliAppendResult(OT_ERROR_NONE);
+}
+
+static void printMainloopTime(const char *aName, const otSysMainloopTime *aTime, uint64_t aInterval)
+{
+    otCliOutputFormat("  %s: %u ms (%u%%), max %u us, runs %u\r\n", aName, (uint32_t)(aTime->mTotalTime / 1000),
+                      (uint32_t)(aTime->mTotalTime * 100 / aInterval), aTime->mMaxTime, aTime->mRuns);
+}
+
+static void processMainloop(int argc, char *argv[])
+{
+    static const char *const kPhaseNames[]  = {"tasklets", "update", "poll", "process", "api lock"};
+    static const char *const kSourceNames[] = {"vfs event", "cli uart", "radio", "alarm", "handlers", "api calls"};
+    otSysMainloopStats       stats;
+    uint64_t                 interval;
+    uint64_t                 idle;
+
+    if (argc > 0 && strcmp(argv[0], "reset") == 0)
+    {
+        otSysResetMainloopStats();
+        otCliAppendResult(OT_ERROR_NONE);
+        return;
+    }
+
+    otSysGetMainloopStats(&stats);
+    interval = stats.mIntervalTime > 0 ? stats.mIntervalTime : 1;
+    idle     = stats.mPhases[OT_SYS_MAINLOOP_PHASE_POLL].mTotalTime;
+
+    otCliOutputFormat("interval: %u ms\r\n", (uint32_t)(stats.mIntervalTime / 1000));
+    otCliOutputFormat("iterations: %u (%u/s)\r\n", stats.mIterations,
+                      (uint32_t)((uint64_t)stats.mIterations * 1000000 / interval));
+    otCliOutputFormat("busy: %u ms (%u%%)\r\n", (uint32_t)((stats.mIntervalTime - idle) / 1000),
+                      (uint32_t)((stats.mIntervalTime - idle) * 100 / interval));
+    otCliOutputFormat("idle: %u ms (%u%%)\r\n", (uint32_t)(idle / 1000), (uint32_t)(idle * 100 / interval));
+
+    otCliOutputFormat("phases:\r\n");
+    for (int i = 0; i < OT_SYS_MAINLOOP_PHASE_NUM; i++)
+    {
+        printMainloopTime(kPhaseNames[i], &stats.mPhases[i], interval);
+    }
+
+    otCliOutputFormat("sources:\r\n");
+    for (int i = 0; i < OT_SYS_MAINLOOP_SOURCE_NUM; i++)
+    {
+        printMainloopTime(kSourceNames[i], &stats.mSources[i], interval);
+    }
+
+    otCliAppendResult(OT_ERROR_NONE);
+}
+
+static const otCliCommand sCommands[] = {
+    {"alarm", processAlarm},
+    {"apilock", processApiLock},
+    {"mainloop", processMainloop},
+    {"power", processPower},
+    {"rcplink", processRcpLink},
+};
+
 static void run_cli(void *aContext)
 {
     OT_UNUSED_VARIABLE(aContext);
@@ -63,14 +281,16 @@ pseudo_reset:
     size_t instanceSize = 0;
 
     // Get the instance size.
-    otInstanceInit(NULL, &instanceSize);
+    otSysInstanceInit(NULL, &instanceSize);
     void *instanceBuffer = malloc(instanceSize);
 
-    otInstance *instance = otInstanceInit(instanceBuffer, &instanceSize);
+    otInstance *instance = otSysInstanceInit(instanceBuffer, &instanceSize);
 
     assert(instance != NULL);
 
     otCliUartInit(instance);
+    otCliSetUserCommands(sCommands, sizeof(sCommands) / sizeof(sCommands[0]));
+    sInstance = instance;
     otSysApiUnlock();
 
     if (!heap_caps_check_integrity_all(true))
@@ -103,7 +323,7 @@ pseudo_reset:
         }
     }
 
-    otInstanceFinalize(instance);
+    otSysInstanceFinalize(instance);
     otSysDeinit();
 
     goto pseudo_reset;
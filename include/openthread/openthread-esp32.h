@@ -68,6 +68,223 @@ typedef struct otSysMainloopContext
     struct timeval mTimeout;    ///< The timeout.
 } otSysMainloopContext;
 
+/**
+ * This structure represents the receive statistics of a uart.
+ *
+ */
+typedef struct otSysUartStats
+{
+    uint32_t mFifoOverflows;     ///< The number of hardware FIFO overflows, received bytes were lost.
+    uint32_t mBufferFullEvents;  ///< The number of times the driver receive buffer was full.
+    uint32_t mFrameErrors;       ///< The number of framing or parity errors.
+    uint32_t mHdlcResyncs;       ///< The number of times the HDLC decoder dropped a partial frame (radio uart only).
+    uint32_t mRxBufferSize;      ///< The size of the driver receive buffer.
+    uint32_t mRxBufferHighWater; ///< The largest number of bytes seen in the driver receive buffer.
+} otSysUartStats;
+
+/**
+ * The number of buckets of the spinel response latency histogram.
+ *
+ */
+#define OT_SYS_RCP_LATENCY_BUCKETS 10
+
+/**
+ * This structure represents the statistics of the link to the Radio Co-processor (RCP).
+ *
+ * Byte counters count the HDLC encoded bytes on the wire. Bucket 0 of the latency histogram counts responses
+ * received within 1 ms, bucket `i` counts responses received within [2^(i-1), 2^i) ms and the last bucket counts
+ * all slower responses.
+ *
+ */
+typedef struct otSysRcpLinkStats
+{
+    uint32_t mTxFrames;          ///< The number of frames sent.
+    uint32_t mTxBytes;           ///< The number of bytes sent.
+    uint32_t mRxFrames;          ///< The number of valid frames received.
+    uint32_t mRxBytes;           ///< The number of bytes received.
+    uint32_t mFcsErrors;         ///< The number of frames dropped due to a FCS mismatch.
+    uint32_t mDroppedFrames;     ///< The number of frames dropped for other reasons.
+    uint32_t mWriteTimeouts;     ///< The number of frames not sent because the link did not become writable.
+    uint64_t mWriteBlockedTime;  ///< The total time in microseconds spent waiting for the link to become writable.
+    uint32_t mLatencyHistogram[OT_SYS_RCP_LATENCY_BUCKETS]; ///< Frame sent to response received latencies.
+} otSysRcpLinkStats;
+
+/**
+ * The number of buckets of the alarm lateness histogram.
+ *
+ */
+#define OT_SYS_ALARM_LATENESS_BUCKETS 16
+
+/**
+ * This structure represents the statistics of an alarm.
+ *
+ * Lateness is the time from the alarm deadline to the alarm being fired to OpenThread. Bucket 0 of the lateness
+ * histogram counts alarms fired within 1 us, bucket `i` counts alarms fired within [2^(i-1), 2^i) us and the last
+ * bucket counts all later alarms.
+ *
+ */
+typedef struct otSysAlarmStats
+{
+    uint32_t mFired;                                            ///< The number of alarms fired.
+    uint32_t mMaxLateness;                                      ///< The largest lateness in microseconds.
+    uint32_t mLatenessHistogram[OT_SYS_ALARM_LATENESS_BUCKETS]; ///< Deadline to fired latenesses.
+} otSysAlarmStats;
+
+/**
+ * This structure represents the power statistics of an interval.
+ *
+ * The mainloop is idle while it waits for events in the low power state with all radios idle. Light sleep is only
+ * allowed then, the chip enters it whenever no other task runs. The time actually spent in light sleep is not known,
+ * the idle time is an upper bound of it.
+ *
+ */
+typedef struct otSysPowerStats
+{
+    uint64_t mIntervalTime; ///< The length of the interval in microseconds.
+    uint64_t mLowPowerTime; ///< The time in microseconds spent in the low power MCU state.
+    uint64_t mIdleTime;     ///< The time in microseconds the mainloop was idle.
+    uint32_t mIdleWaits;    ///< The number of times the mainloop waited for events while idle.
+} otSysPowerStats;
+
+/**
+ * The number of buckets of the API lock wait and hold time histograms.
+ *
+ */
+#define OT_SYS_API_LOCK_BUCKETS 16
+
+/**
+ * The size of the task names in the API lock statistics, including the terminating null character.
+ *
+ */
+#define OT_SYS_TASK_NAME_SIZE 16
+
+/**
+ * This structure represents the statistics of the API lock.
+ *
+ * Bucket 0 of a histogram counts times within 1 us, bucket `i` counts times within [2^(i-1), 2^i) us and the last
+ * bucket counts all longer times.
+ *
+ */
+typedef struct otSysApiLockStats
+{
+    uint32_t mAcquisitions;                           ///< The number of times the lock has been taken.
+    uint32_t mContentions;                            ///< The number of times the lock was held by another task.
+    uint32_t mMaxWaitTime;                            ///< The longest wait for the lock in microseconds.
+    uint32_t mMaxHoldTime;                            ///< The longest hold of the lock in microseconds.
+    char     mMaxHoldTask[OT_SYS_TASK_NAME_SIZE];     ///< The name of the task which held the lock the longest.
+    void *   mMaxHoldCaller;                          ///< The caller of otSysApiLock() for the longest hold.
+    uint32_t mWaitHistogram[OT_SYS_API_LOCK_BUCKETS]; ///< The wait times for the lock.
+    uint32_t mHoldHistogram[OT_SYS_API_LOCK_BUCKETS]; ///< The hold times of the lock.
+} otSysApiLockStats;
+
+/**
+ * This enumeration defines the phases of a mainloop iteration.
+ *
+ */
+typedef enum otSysMainloopPhase
+{
+    OT_SYS_MAINLOOP_PHASE_TASKLETS, ///< Up to otSysMainloopUpdate() once the API lock is taken, running the tasklets.
+    OT_SYS_MAINLOOP_PHASE_UPDATE,   ///< otSysMainloopUpdate().
+    OT_SYS_MAINLOOP_PHASE_POLL,     ///< otSysMainloopPoll(), waiting for events.
+    OT_SYS_MAINLOOP_PHASE_PROCESS,  ///< otSysMainloopProcess().
+    OT_SYS_MAINLOOP_PHASE_API_LOCK, ///< Waiting for otSysApiLock() after otSysMainloopInit() or otSysMainloopPoll().
+    OT_SYS_MAINLOOP_PHASE_NUM,      ///< The number of phases.
+} otSysMainloopPhase;
+
+/**
+ * This enumeration defines the platform sources updated and processed by the mainloop.
+ *
+ */
+typedef enum otSysMainloopSource
+{
+    OT_SYS_MAINLOOP_SOURCE_VFS_EVENT, ///< The mainloop events.
+    OT_SYS_MAINLOOP_SOURCE_CLI_UART,  ///< The CLI uart.
+    OT_SYS_MAINLOOP_SOURCE_RADIO,     ///< The radio.
+    OT_SYS_MAINLOOP_SOURCE_ALARM,     ///< The alarms.
+    OT_SYS_MAINLOOP_SOURCE_HANDLERS,  ///< The application handlers, see otSysMainloopAddHandler().
+    OT_SYS_MAINLOOP_SOURCE_API_CALLS, ///< The queued API calls, see otSysApiCallAsync().
+    OT_SYS_MAINLOOP_SOURCE_NUM,       ///< The number of sources.
+} otSysMainloopSource;
+
+/**
+ * This structure represents the time spent in a mainloop phase or source.
+ *
+ */
+typedef struct otSysMainloopTime
+{
+    uint64_t mTotalTime; ///< The total time in microseconds.
+    uint32_t mMaxTime;   ///< The longest single run in microseconds.
+    uint32_t mRuns;      ///< The number of runs.
+} otSysMainloopTime;
+
+/**
+ * This structure represents the mainloop statistics of an interval.
+ *
+ * The time of a source adds up both its update and its process. The mainloop is idle during the poll phase, blocked
+ * by other tasks during the API lock phase and busy for the rest of the interval.
+ *
+ */
+typedef struct otSysMainloopStats
+{
+    uint64_t          mIntervalTime;                        ///< The length of the interval in microseconds.
+    uint32_t          mIterations;                          ///< The number of mainloop iterations.
+    otSysMainloopTime mPhases[OT_SYS_MAINLOOP_PHASE_NUM];   ///< The time spent in each phase.
+    otSysMainloopTime mSources[OT_SYS_MAINLOOP_SOURCE_NUM]; ///< The time spent in each platform source.
+} otSysMainloopStats;
+
+/**
+ * This function pointer is called in the OpenThread task to run a queued API call.
+ *
+ * @param[in]  aInstance  The OpenThread instance of the mainloop.
+ * @param[in]  aContext   A pointer to the call context.
+ *
+ */
+typedef void (*otSysApiFunction)(otInstance *aInstance, void *aContext);
+
+/**
+ * This function pointer is called in the OpenThread task once a queued API call has completed.
+ *
+ * @param[in]  aContext  A pointer to the call context.
+ * @param[in]  aError    OT_ERROR_NONE if the call has been run, OT_ERROR_ABORT if it has been dropped by otSysDeinit().
+ *
+ */
+typedef void (*otSysApiCompletion)(void *aContext, otError aError);
+
+/**
+ * This function pointer is called by otSysMainloopUpdate().
+ *
+ * The handler adds its file descriptors and lowers the timeout of the mainloop context as needed.
+ *
+ * @param[in]    aContext   A pointer to the handler context.
+ * @param[inout] aMainloop  The mainloop context.
+ *
+ */
+typedef void (*otSysMainloopUpdateCallback)(void *aContext, otSysMainloopContext *aMainloop);
+
+/**
+ * This function pointer is called by otSysMainloopProcess().
+ *
+ * @param[in]  aContext   A pointer to the handler context.
+ * @param[in]  aMainloop  The mainloop context.
+ * @param[in]  aSignaled  TRUE if the handler has been signaled or its file descriptor is readable, FALSE otherwise.
+ *
+ */
+typedef void (*otSysMainloopProcessCallback)(void *aContext, const otSysMainloopContext *aMainloop, bool aSignaled);
+
+/**
+ * This structure represents an application handler run by the OpenThread mainloop.
+ *
+ * Handlers run in the mainloop task with the API lock held, so they may call OpenThread APIs directly.
+ *
+ */
+typedef struct otSysMainloopHandler
+{
+    otSysMainloopUpdateCallback  mUpdate;  ///< Called by otSysMainloopUpdate(), may be NULL.
+    otSysMainloopProcessCallback mProcess; ///< Called by otSysMainloopProcess(), may be NULL.
+    void *                       mContext; ///< The context passed to the callbacks.
+    int                          mFd;      ///< A file descriptor the mainloop waits to be readable, or -1 for none.
+} otSysMainloopHandler;
+
 /**
  * This function performs all platform-specific initialization of OpenThread's drivers.
  *
@@ -89,6 +306,28 @@ void otSysInit(int argc, char *argv[]);
  */
 void otSysDeinit(void);
 
+/**
+ * This function initializes an OpenThread instance and gives it the next free radio and alarm.
+ *
+ * It MUST be used instead of otInstanceInit(), so that the radio and the alarm of the instance are known before
+ * OpenThread first uses them. The platform functions called for an instance not initialized this way are fatal.
+ *
+ * @param[in]    aInstanceBuffer      The buffer OpenThread constructs the instance in, or NULL to query its size.
+ * @param[inout] aInstanceBufferSize  On input the size of @p aInstanceBuffer, on output the size needed.
+ *
+ * @returns A pointer to the new instance, or NULL if the buffer is too small or all radios are in use.
+ *
+ */
+otInstance *otSysInstanceInit(void *aInstanceBuffer, size_t *aInstanceBufferSize);
+
+/**
+ * This function finalizes an OpenThread instance initialized by otSysInstanceInit() and frees its radio and alarm.
+ *
+ * @param[in]  aInstance  The OpenThread instance structure.
+ *
+ */
+void otSysInstanceFinalize(otInstance *aInstance);
+
 /**
  * This function returns true if a pseudo-reset was requested.
  *
@@ -164,6 +403,231 @@ void otSysApiLock(void);
  */
 void otSysApiUnlock(void);
 
+/**
+ * This function gets the statistics of the API lock.
+ *
+ * The statistics are only recorded with OT_API_LOCK_STATS_ENABLE, they are all zero otherwise.
+ *
+ * @param[out] aStats  A pointer to the statistics.
+ *
+ */
+void otSysGetApiLockStats(otSysApiLockStats *aStats);
+
+/**
+ * This function resets the statistics of the API lock.
+ *
+ */
+void otSysResetApiLockStats(void);
+
+/**
+ * This function queues an OpenThread API call, to be run in the OpenThread task.
+ *
+ * The mainloop is woken up and runs the queued calls in otSysMainloopProcess(), after the platform drivers and with
+ * the API lock held, so the calling task never waits for the lock. This function may be called from any task, but
+ * not from an interrupt handler.
+ *
+ * @param[in]  aFunction    The function running the call.
+ * @param[in]  aContext     A pointer to the call context.
+ * @param[in]  aCompletion  The function called once the call has completed, may be NULL.
+ *
+ * @retval OT_ERROR_NONE           Successfully queued the call.
+ * @retval OT_ERROR_INVALID_ARGS   @p aFunction is NULL.
+ * @retval OT_ERROR_INVALID_STATE  The platform is not initialized.
+ * @retval OT_ERROR_NO_BUFS        OT_API_CALL_QUEUE_SIZE calls are already queued.
+ *
+ */
+otError otSysApiCallAsync(otSysApiFunction aFunction, void *aContext, otSysApiCompletion aCompletion);
+
+/**
+ * This function runs an OpenThread API call in the OpenThread task and waits for it to complete.
+ *
+ * Called from the OpenThread task, the call is run right away. Other tasks MUST NOT hold the API lock, the mainloop
+ * needs it to run the call.
+ *
+ * @param[in]  aFunction  The function running the call.
+ * @param[in]  aContext   A pointer to the call context.
+ *
+ * @retval OT_ERROR_NONE           The call has been run.
+ * @retval OT_ERROR_INVALID_ARGS   @p aFunction is NULL.
+ * @retval OT_ERROR_INVALID_STATE  The platform is not initialized, or the calling task holds the API lock.
+ * @retval OT_ERROR_NO_BUFS        The call could not be queued.
+ * @retval OT_ERROR_ABORT          The call has been dropped by otSysDeinit().
+ *
+ */
+otError otSysApiCall(otSysApiFunction aFunction, void *aContext);
+
+/**
+ * This function gets the receive statistics of the radio uart.
+ *
+ * All the statistics are zero when the RCP is connected over SPI.
+ *
+ * @param[in]  aInstance  The OpenThread instance structure.
+ * @param[out] aStats     A pointer to the statistics, all zero if @p aInstance has no radio.
+ *
+ */
+void otSysGetRadioUartStats(otInstance *aInstance, otSysUartStats *aStats);
+
+/**
+ * This function gets the receive statistics of the CLI uart.
+ *
+ * @param[in]  aInstance  The OpenThread instance structure.
+ * @param[out] aStats     A pointer to the statistics.
+ *
+ */
+void otSysGetCliUartStats(otInstance *aInstance, otSysUartStats *aStats);
+
+/**
+ * This function gets the statistics of the link to the Radio Co-processor (RCP).
+ *
+ * @param[in]  aInstance  The OpenThread instance structure.
+ * @param[out] aStats     A pointer to the statistics, all zero if @p aInstance has no radio.
+ *
+ */
+void otSysGetRcpLinkStats(otInstance *aInstance, otSysRcpLinkStats *aStats);
+
+/**
+ * This function resets the statistics of the link to the Radio Co-processor (RCP).
+ *
+ * @param[in]  aInstance  The OpenThread instance structure.
+ *
+ */
+void otSysResetRcpLinkStats(otInstance *aInstance);
+
+/**
+ * This function resets the receive statistics of both the radio and the CLI uart.
+ *
+ * @param[in]  aInstance  The OpenThread instance structure.
+ *
+ */
+void otSysResetUartStats(otInstance *aInstance);
+
+/**
+ * This function converts a time of the Radio Co-processor (RCP) clock, e.g. the timestamp of a received frame, to the
+ * host clock used by otPlatTimeGet().
+ *
+ * The offset and the drift between both clocks are estimated from the timestamps of the frames received by the RCP.
+ *
+ * @param[in]  aInstance  The OpenThread instance structure.
+ * @param[in]  aRcpTime   The RCP time in microseconds.
+ * @param[out] aHostTime  A pointer to the host time in microseconds.
+ *
+ * @retval OT_ERROR_NONE           Successfully converted the time.
+ * @retval OT_ERROR_INVALID_STATE  No timestamped frame has been received from the RCP yet.
+ * @retval OT_ERROR_INVALID_ARGS   @p aInstance has no radio.
+ *
+ */
+otError otSysConvertRcpTimeToHostTime(otInstance *aInstance, uint64_t aRcpTime, uint64_t *aHostTime);
+
+/**
+ * This function converts a time of the host clock used by otPlatTimeGet() to the Radio Co-processor (RCP) clock, e.g.
+ * to schedule a transmission.
+ *
+ * @param[in]  aInstance  The OpenThread instance structure.
+ * @param[in]  aHostTime  The host time in microseconds.
+ * @param[out] aRcpTime   A pointer to the RCP time in microseconds.
+ *
+ * @retval OT_ERROR_NONE           Successfully converted the time.
+ * @retval OT_ERROR_INVALID_STATE  No timestamped frame has been received from the RCP yet.
+ * @retval OT_ERROR_INVALID_ARGS   @p aInstance has no radio.
+ *
+ */
+otError otSysConvertHostTimeToRcpTime(otInstance *aInstance, uint64_t aHostTime, uint64_t *aRcpTime);
+
+/**
+ * This function gets the estimated drift of the host clock relative to the Radio Co-processor (RCP) clock.
+ *
+ * @param[in]  aInstance  The OpenThread instance structure.
+ *
+ * @returns The drift in parts per billion, positive when the host clock runs faster, 0 if @p aInstance has no radio.
+ *
+ */
+int32_t otSysGetRcpClockDrift(otInstance *aInstance);
+
+/**
+ * This function gets the statistics of the microsecond alarm.
+ *
+ * @param[in]  aInstance  The OpenThread instance structure.
+ * @param[out] aStats     A pointer to the statistics, all zero if @p aInstance has no radio.
+ *
+ */
+void otSysGetAlarmMicroStats(otInstance *aInstance, otSysAlarmStats *aStats);
+
+/**
+ * This function resets the statistics of the microsecond alarm.
+ *
+ * @param[in]  aInstance  The OpenThread instance structure.
+ *
+ */
+void otSysResetAlarmMicroStats(otInstance *aInstance);
+
+/**
+ * This function gets the power statistics since the interval started.
+ *
+ * @param[out] aStats  A pointer to the statistics.
+ *
+ */
+void otSysGetPowerStats(otSysPowerStats *aStats);
+
+/**
+ * This function resets the power statistics and starts a new interval.
+ *
+ */
+void otSysResetPowerStats(void);
+
+/**
+ * This function gets the mainloop statistics since the interval started.
+ *
+ * @param[out] aStats  A pointer to the statistics.
+ *
+ */
+void otSysGetMainloopStats(otSysMainloopStats *aStats);
+
+/**
+ * This function resets the mainloop statistics and starts a new interval.
+ *
+ */
+void otSysResetMainloopStats(void);
+
+/**
+ * This function adds an application handler to the mainloop.
+ *
+ * The handler is referenced, not copied, and must stay valid until it is removed. This function must be called with
+ * the API lock held.
+ *
+ * @param[in]  aHandler  A pointer to the handler.
+ *
+ * @retval OT_ERROR_NONE          Successfully added the handler.
+ * @retval OT_ERROR_ALREADY       The handler has already been added.
+ * @retval OT_ERROR_NO_BUFS       OT_MAINLOOP_HANDLER_MAX handlers have already been added.
+ * @retval OT_ERROR_INVALID_ARGS  The handler has a file descriptor, which the event group mainloop does not wait for.
+ *
+ */
+otError otSysMainloopAddHandler(const otSysMainloopHandler *aHandler);
+
+/**
+ * This function removes an application handler from the mainloop.
+ *
+ * This function must be called with the API lock held. A handler may remove itself from its callbacks.
+ *
+ * @param[in]  aHandler  A pointer to the handler.
+ *
+ * @retval OT_ERROR_NONE       Successfully removed the handler.
+ * @retval OT_ERROR_NOT_FOUND  The handler has not been added.
+ *
+ */
+otError otSysMainloopRemoveHandler(const otSysMainloopHandler *aHandler);
+
+/**
+ * This function signals an application handler and wakes up the mainloop.
+ *
+ * The next process callback of the handler is called with @p aSignaled set. Signals are not counted. This function
+ * may be called from any task, but not from an interrupt handler.
+ *
+ * @param[in]  aHandler  A pointer to the handler.
+ *
+ */
+void otSysMainloopSignal(const otSysMainloopHandler *aHandler);
+
 #ifdef __cplusplus
 } // end of extern "C"
 #endif
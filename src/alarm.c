@@ -30,6 +30,7 @@
 
 #include <stdbool.h>
 #include <stdint.h>
+#include <string.h>
 
 #include <freertos/FreeRTOS.h>
 #include <freertos/task.h>
@@ -37,45 +38,115 @@
 #include <esp_log.h>
 #include <esp_timer.h>
 
-#include <sys/time.h>
-
 #include <openthread/config.h>
+#include <openthread/platform/alarm-micro.h>
 #include <openthread/platform/alarm-milli.h>
 #include <openthread/platform/diag.h>
 #include <openthread/platform/time.h>
 
 #include "error_handling.h"
 
-static uint64_t sAlarmT0   = 0;
-static uint64_t sAlarmDt   = 0;
-static bool     sIsRunning = false;
+typedef struct Alarm
+{
+    otInstance *       mInstance;
+    uint32_t           mT0;
+    uint32_t           mDt;
+    bool               mIsRunning;
+    esp_timer_handle_t mTimer;
+    uint32_t           mMicroT0;
+    uint32_t           mMicroDt;
+    bool               mMicroIsRunning;
+    esp_timer_handle_t mMicroTimer;
+    otSysAlarmStats    mMicroStats;
+} Alarm;
+
+/**
+ * The alarms of the OpenThread instances, one per radio.
+ */
+static Alarm sAlarms[OT_RADIO_NUM];
+
+/**
+ * This function returns the alarm of an OpenThread instance, or NULL if the instance has none.
+ *
+ */
+static Alarm *findAlarm(otInstance *aInstance)
+{
+    Alarm *alarm = NULL;
+
+    VerifyOrExit(aInstance != NULL, OT_NOOP);
+
+    for (int i = 0; i < OT_RADIO_NUM; i++)
+    {
+        if (sAlarms[i].mInstance == aInstance)
+        {
+            ExitNow(alarm = &sAlarms[i]);
+        }
+    }
+
+exit:
+    return alarm;
+}
+
+/**
+ * This function returns the alarm of an OpenThread instance created by `otSysInstanceInit()`.
+ *
+ */
+static Alarm *getAlarm(otInstance *aInstance)
+{
+    Alarm *alarm = findAlarm(aInstance);
+
+    VerifyOrDie(alarm != NULL, OT_EXIT_FAILURE);
+
+    return alarm;
+}
 
 uint64_t otPlatTimeGet(void)
 {
-    struct timeval tv_now;
+    // The time since boot, unlike the time of day it is never adjusted.
+    return (uint64_t)esp_timer_get_time();
+}
 
-    int err = gettimeofday(&tv_now, NULL);
-    VerifyOrDie(err == 0, OT_EXIT_FAILURE);
+static void handleMilliTimer(void *aArg)
+{
+    OT_UNUSED_VARIABLE(aArg);
 
-    return (uint64_t)tv_now.tv_sec * OT_US_PER_S + tv_now.tv_usec;
+    // Runs in the esp_timer task, the alarm is fired from the mainloop.
+    platformVfsEventSignal(OT_EVENT_ALARM_MILLI);
 }
 
 void otPlatAlarmMilliStartAt(otInstance *aInstance, uint32_t aT0, uint32_t aDt)
 {
-    OT_UNUSED_VARIABLE(aInstance);
+    Alarm * alarm     = getAlarm(aInstance);
+    int64_t now       = esp_timer_get_time();
+    int32_t remaining = (int32_t)(aT0 + aDt - (uint32_t)(now / OT_US_PER_MS));
+
+    alarm->mT0        = aT0;
+    alarm->mDt        = aDt;
+    alarm->mIsRunning = true;
 
-    sAlarmT0   = aT0;
-    sAlarmDt   = aDt;
-    sIsRunning = true;
+    // Fails harmlessly when the timer is not running.
+    esp_timer_stop(alarm->mTimer);
 
-    ESP_LOGD(OT_PLAT_LOG_TAG, "alarm start running, t0=%llu, dt=%llu", sAlarmT0, sAlarmDt);
+    if (remaining > 0)
+    {
+        // Expire on the millisecond boundary at which otPlatAlarmMilliGetNow() reaches the deadline.
+        ESP_ERROR_CHECK(
+            esp_timer_start_once(alarm->mTimer, (uint64_t)remaining * OT_US_PER_MS - (uint64_t)(now % OT_US_PER_MS)));
+    }
+    else
+    {
+        platformVfsEventSignal(OT_EVENT_ALARM_MILLI);
+    }
+
+    ESP_LOGD(OT_PLAT_LOG_TAG, "alarm start running, t0=%u, dt=%u", alarm->mT0, alarm->mDt);
 }
 
 void otPlatAlarmMilliStop(otInstance *aInstance)
 {
-    OT_UNUSED_VARIABLE(aInstance);
+    Alarm *alarm = getAlarm(aInstance);
 
-    sIsRunning = false;
+    alarm->mIsRunning = false;
+    esp_timer_stop(alarm->mTimer);
 }
 
 uint32_t otPlatAlarmMilliGetNow(void)
@@ -83,52 +154,211 @@ uint32_t otPlatAlarmMilliGetNow(void)
     return esp_timer_get_time() / OT_US_PER_MS;
 }
 
-void platformAlarmUpdate(otSysMainloopContext *aMainloop)
+static void handleMicroTimer(void *aArg)
 {
-    struct timeval *timeout = &aMainloop->mTimeout;
-    uint32_t        now     = otPlatAlarmMilliGetNow();
+    OT_UNUSED_VARIABLE(aArg);
 
-    if (!sIsRunning)
+    // Runs in the esp_timer task, the alarm is fired from the mainloop.
+    platformVfsEventSignal(OT_EVENT_ALARM_MICRO);
+}
+
+void otPlatAlarmMicroStartAt(otInstance *aInstance, uint32_t aT0, uint32_t aDt)
+{
+    Alarm * alarm     = getAlarm(aInstance);
+    int32_t remaining = (int32_t)(aT0 + aDt - otPlatAlarmMicroGetNow());
+
+    alarm->mMicroT0        = aT0;
+    alarm->mMicroDt        = aDt;
+    alarm->mMicroIsRunning = true;
+
+    // Fails harmlessly when the timer is not running.
+    esp_timer_stop(alarm->mMicroTimer);
+
+    if (remaining > 0)
     {
-        timeout->tv_sec  = INT32_MAX;
-        timeout->tv_usec = 0;
+        ESP_ERROR_CHECK(esp_timer_start_once(alarm->mMicroTimer, (uint64_t)remaining));
     }
-    else if (sAlarmDt + sAlarmT0 > now)
+    else
     {
-        uint64_t remaining = sAlarmDt + sAlarmT0 - now;
-        timeout->tv_sec    = remaining / OT_MS_PER_S;
-        timeout->tv_usec   = (remaining % OT_MS_PER_S) * OT_US_PER_MS;
+        platformVfsEventSignal(OT_EVENT_ALARM_MICRO);
     }
-    else
+}
+
+void otPlatAlarmMicroStop(otInstance *aInstance)
+{
+    Alarm *alarm = getAlarm(aInstance);
+
+    alarm->mMicroIsRunning = false;
+    esp_timer_stop(alarm->mMicroTimer);
+}
+
+uint32_t otPlatAlarmMicroGetNow(void)
+{
+    return (uint32_t)esp_timer_get_time();
+}
+
+static void recordMicroLateness(otSysAlarmStats *aStats, uint32_t aLateness)
+{
+    uint32_t lateness = aLateness;
+    uint8_t  bucket   = 0;
+
+    while (lateness > 0 && bucket < OT_SYS_ALARM_LATENESS_BUCKETS - 1)
     {
-        timeout->tv_sec  = 0;
-        timeout->tv_usec = 0;
+        lateness >>= 1;
+        bucket++;
+    }
+
+    aStats->mFired++;
+    aStats->mLatenessHistogram[bucket]++;
+
+    if (aLateness > aStats->mMaxLateness)
+    {
+        aStats->mMaxLateness = aLateness;
+    }
+}
+
+void otSysGetAlarmMicroStats(otInstance *aInstance, otSysAlarmStats *aStats)
+{
+    Alarm *alarm = findAlarm(aInstance);
+
+    memset(aStats, 0, sizeof(*aStats));
+    VerifyOrExit(alarm != NULL, OT_NOOP);
+
+    *aStats = alarm->mMicroStats;
+
+exit:
+    return;
+}
+
+void otSysResetAlarmMicroStats(otInstance *aInstance)
+{
+    Alarm *alarm = findAlarm(aInstance);
+
+    VerifyOrExit(alarm != NULL, OT_NOOP);
+    memset(&alarm->mMicroStats, 0, sizeof(otSysAlarmStats));
+
+exit:
+    return;
+}
+
+void platformAlarmInit(void)
+{
+    esp_timer_create_args_t milliTimerArgs = {
+        .callback        = handleMilliTimer,
+        .arg             = NULL,
+        .dispatch_method = ESP_TIMER_TASK,
+        .name            = "ot_alarm_ms",
+    };
+    esp_timer_create_args_t microTimerArgs = {
+        .callback        = handleMicroTimer,
+        .arg             = NULL,
+        .dispatch_method = ESP_TIMER_TASK,
+        .name            = "ot_alarm_us",
+    };
+
+    memset(sAlarms, 0, sizeof(sAlarms));
+
+    for (int i = 0; i < OT_RADIO_NUM; i++)
+    {
+        ESP_ERROR_CHECK(esp_timer_create(&milliTimerArgs, &sAlarms[i].mTimer));
+        ESP_ERROR_CHECK(esp_timer_create(&microTimerArgs, &sAlarms[i].mMicroTimer));
+    }
+}
+
+otError platformAlarmAddInstance(otInstance *aInstance)
+{
+    otError error = OT_ERROR_NO_BUFS;
+
+    VerifyOrExit(findAlarm(aInstance) == NULL, error = OT_ERROR_NONE);
+
+    for (int i = 0; i < OT_RADIO_NUM; i++)
+    {
+        if (sAlarms[i].mInstance == NULL)
+        {
+            sAlarms[i].mInstance = aInstance;
+            memset(&sAlarms[i].mMicroStats, 0, sizeof(otSysAlarmStats));
+            ExitNow(error = OT_ERROR_NONE);
+        }
+    }
+
+exit:
+    return error;
+}
+
+void platformAlarmRemoveInstance(otInstance *aInstance)
+{
+    Alarm *alarm = findAlarm(aInstance);
+
+    VerifyOrExit(alarm != NULL, OT_NOOP);
+
+    alarm->mIsRunning      = false;
+    alarm->mMicroIsRunning = false;
+    esp_timer_stop(alarm->mTimer);
+    esp_timer_stop(alarm->mMicroTimer);
+    alarm->mInstance = NULL;
+
+exit:
+    return;
+}
+
+void platformAlarmDeinit(void)
+{
+    for (int i = 0; i < OT_RADIO_NUM; i++)
+    {
+        esp_timer_stop(sAlarms[i].mTimer);
+        ESP_ERROR_CHECK(esp_timer_delete(sAlarms[i].mTimer));
+        sAlarms[i].mTimer = NULL;
+
+        esp_timer_stop(sAlarms[i].mMicroTimer);
+        ESP_ERROR_CHECK(esp_timer_delete(sAlarms[i].mMicroTimer));
+        sAlarms[i].mMicroTimer = NULL;
     }
 }
 
 void platformAlarmProcess(otInstance *aInstance, const otSysMainloopContext *aMainloop)
 {
+    OT_UNUSED_VARIABLE(aInstance);
     OT_UNUSED_VARIABLE(aMainloop);
 
-    if (sIsRunning)
+    // Nothing to do unless one of the alarm timers has expired.
+    VerifyOrExit(platformVfsEventIsSignaled(OT_EVENT_ALARM_MILLI | OT_EVENT_ALARM_MICRO), OT_NOOP);
+
+    for (int i = 0; i < OT_RADIO_NUM; i++)
     {
-        if (sAlarmT0 + sAlarmDt <= otPlatAlarmMilliGetNow())
+        Alarm *alarm = &sAlarms[i];
+
+        if (alarm->mIsRunning && (int32_t)(otPlatAlarmMilliGetNow() - (alarm->mT0 + alarm->mDt)) >= 0)
         {
-            sIsRunning = false;
+            alarm->mIsRunning = false;
 
 #if OPENTHREAD_CONFIG_DIAG_ENABLE
 
             if (otPlatDiagModeGet())
             {
-                otPlatDiagAlarmFired(aInstance);
+                otPlatDiagAlarmFired(alarm->mInstance);
             }
             else
 #endif
             {
-                otPlatAlarmMilliFired(aInstance);
+                otPlatAlarmMilliFired(alarm->mInstance);
             }
 
             ESP_LOGD(OT_PLAT_LOG_TAG, "alarm fired");
         }
+
+        if (alarm->mMicroIsRunning)
+        {
+            int32_t lateness = (int32_t)(otPlatAlarmMicroGetNow() - (alarm->mMicroT0 + alarm->mMicroDt));
+
+            if (lateness >= 0)
+            {
+                alarm->mMicroIsRunning = false;
+                recordMicroLateness(&alarm->mMicroStats, (uint32_t)lateness);
+                otPlatAlarmMicroFired(alarm->mInstance);
+            }
+        }
     }
+
+exit:
+    return;
 }
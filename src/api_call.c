@@ -0,0 +1,229 @@
+/*
+ *  Copyright (c) 2020, The OpenThread Authors.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  3. Neither the name of the copyright holder nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file implements the OpenThread API call queue.
+ *
+ *   Application tasks queue calls which the mainloop runs in the OpenThread task, instead of taking the API lock.
+ */
+
+#include "platform-esp32.h"
+
+#include <freertos/FreeRTOS.h>
+#include <freertos/queue.h>
+#include <freertos/semphr.h>
+#include <freertos/task.h>
+
+#include <openthread/openthread-esp32.h>
+
+#include "error_handling.h"
+
+typedef struct ApiCall
+{
+    otSysApiFunction   mFunction;
+    void *             mContext;
+    otSysApiCompletion mCompletion;
+} ApiCall;
+
+typedef struct BlockingApiCall
+{
+    otSysApiFunction  mFunction;
+    void *            mContext;
+    SemaphoreHandle_t mDone;
+    otError           mError;
+} BlockingApiCall;
+
+static QueueHandle_t         sQueue        = NULL;
+static volatile TaskHandle_t sMainloopTask = NULL;
+static otInstance *          sLastInstance = NULL;
+
+// Protects sQueue and sQueueUsers, the queue is only deleted once no task is sending to it anymore.
+static portMUX_TYPE sQueueLock  = portMUX_INITIALIZER_UNLOCKED;
+static uint32_t     sQueueUsers = 0;
+
+static void runBlockingCall(otInstance *aInstance, void *aContext)
+{
+    BlockingApiCall *call = (BlockingApiCall *)aContext;
+
+    call->mFunction(aInstance, call->mContext);
+}
+
+static void completeBlockingCall(void *aContext, otError aError)
+{
+    BlockingApiCall *call = (BlockingApiCall *)aContext;
+
+    call->mError = aError;
+    xSemaphoreGive(call->mDone);
+}
+
+otError otSysApiCallAsync(otSysApiFunction aFunction, void *aContext, otSysApiCompletion aCompletion)
+{
+    otError       error = OT_ERROR_NONE;
+    ApiCall       call  = {.mFunction = aFunction, .mContext = aContext, .mCompletion = aCompletion};
+    QueueHandle_t queue;
+
+    VerifyOrExit(aFunction != NULL, error = OT_ERROR_INVALID_ARGS);
+
+    portENTER_CRITICAL(&sQueueLock);
+    queue = sQueue;
+
+    if (queue != NULL)
+    {
+        sQueueUsers++;
+    }
+    portEXIT_CRITICAL(&sQueueLock);
+
+    VerifyOrExit(queue != NULL, error = OT_ERROR_INVALID_STATE);
+
+    if (xQueueSend(queue, &call, 0) == pdTRUE)
+    {
+        platformVfsEventSignal(OT_EVENT_API_CALL);
+    }
+    else
+    {
+        error = OT_ERROR_NO_BUFS;
+    }
+
+    portENTER_CRITICAL(&sQueueLock);
+    sQueueUsers--;
+    portEXIT_CRITICAL(&sQueueLock);
+
+exit:
+    return error;
+}
+
+otError otSysApiCall(otSysApiFunction aFunction, void *aContext)
+{
+    otError         error = OT_ERROR_NONE;
+    BlockingApiCall call  = {.mFunction = aFunction, .mContext = aContext, .mDone = NULL, .mError = OT_ERROR_NONE};
+
+    VerifyOrExit(aFunction != NULL, error = OT_ERROR_INVALID_ARGS);
+
+    if (xTaskGetCurrentTaskHandle() == sMainloopTask)
+    {
+        // Waiting for the mainloop from its own task would never return, the call is run right away.
+        aFunction(sLastInstance, aContext);
+        ExitNow();
+    }
+
+    // The mainloop takes the API lock to run the call, waiting for it with the lock held would never return.
+    VerifyOrExit(!platformApiLockIsHeld(), error = OT_ERROR_INVALID_STATE);
+
+    call.mDone = xSemaphoreCreateBinary();
+    VerifyOrExit(call.mDone != NULL, error = OT_ERROR_NO_BUFS);
+
+    SuccessOrExit(error = otSysApiCallAsync(runBlockingCall, &call, completeBlockingCall));
+    xSemaphoreTake(call.mDone, portMAX_DELAY);
+    error = call.mError;
+
+exit:
+    if (call.mDone != NULL)
+    {
+        vSemaphoreDelete(call.mDone);
+    }
+
+    return error;
+}
+
+void platformApiCallInit(void)
+{
+    sQueue = xQueueCreate(OT_API_CALL_QUEUE_SIZE, sizeof(ApiCall));
+    VerifyOrDie(sQueue != NULL, OT_EXIT_FAILURE);
+}
+
+void platformApiCallDeinit(void)
+{
+    QueueHandle_t queue;
+    ApiCall       call;
+    uint32_t      users;
+
+    portENTER_CRITICAL(&sQueueLock);
+    queue  = sQueue;
+    sQueue = NULL;
+    portEXIT_CRITICAL(&sQueueLock);
+
+    // No call can be queued once the tasks still sending have finished.
+    do
+    {
+        portENTER_CRITICAL(&sQueueLock);
+        users = sQueueUsers;
+        portEXIT_CRITICAL(&sQueueLock);
+
+        if (users > 0)
+        {
+            vTaskDelay(1);
+        }
+    } while (users > 0);
+
+    // The calls left in the queue are completed without being run.
+    while (xQueueReceive(queue, &call, 0) == pdTRUE)
+    {
+        if (call.mCompletion != NULL)
+        {
+            call.mCompletion(call.mContext, OT_ERROR_ABORT);
+        }
+    }
+
+    vQueueDelete(queue);
+    sMainloopTask = NULL;
+    sLastInstance = NULL;
+}
+
+void platformApiCallProcess(otInstance *aInstance)
+{
+    UBaseType_t pending;
+
+    sMainloopTask = xTaskGetCurrentTaskHandle();
+    sLastInstance = aInstance;
+
+    VerifyOrExit(platformVfsEventIsSignaled(OT_EVENT_API_CALL), OT_NOOP);
+
+    // Calls queued while these are running signal the mainloop again, they are run in the next iteration.
+    pending = uxQueueMessagesWaiting(sQueue);
+
+    while (pending-- > 0)
+    {
+        ApiCall call;
+
+        if (xQueueReceive(sQueue, &call, 0) != pdTRUE)
+        {
+            break;
+        }
+
+        call.mFunction(aInstance, call.mContext);
+
+        if (call.mCompletion != NULL)
+        {
+            call.mCompletion(call.mContext, OT_ERROR_NONE);
+        }
+    }
+
+exit:
+    return;
+}
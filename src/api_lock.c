@@ -28,10 +28,17 @@
 
 #include "platform-esp32.h"
 
+#include <stdint.h>
+#include <string.h>
+
+#include <esp_log.h>
+#include <esp_timer.h>
+
 #include <freertos/FreeRTOS.h>
 #include <freertos/portmacro.h>
 #include <freertos/projdefs.h>
 #include <freertos/semphr.h>
+#include <freertos/task.h>
 
 #include <openthread/openthread-esp32.h>
 
@@ -39,15 +46,139 @@
 
 static SemaphoreHandle_t sApiMutex = NULL;
 
+#if OT_API_LOCK_STATS_ENABLE
+static otSysApiLockStats sStats;
+static portMUX_TYPE      sStatsLock = portMUX_INITIALIZER_UNLOCKED;
+
+// The hold started by the current owner, only accessed with the API lock held.
+static uint64_t sHoldStart  = 0;
+static void *   sHoldCaller = NULL;
+
+static void *getCaller(void *aReturnAddress)
+{
+#ifdef __XTENSA__
+    // The windowed ABI stores the window size in the two top bits of return addresses.
+    return (void *)(((uintptr_t)aReturnAddress & 0x3fffffff) | 0x40000000);
+#else
+    return aReturnAddress;
+#endif
+}
+
+static void recordTime(uint32_t *aHistogram, uint32_t aTime)
+{
+    uint32_t time   = aTime;
+    uint8_t  bucket = 0;
+
+    while (time > 0 && bucket < OT_SYS_API_LOCK_BUCKETS - 1)
+    {
+        time >>= 1;
+        bucket++;
+    }
+
+    aHistogram[bucket]++;
+}
+#endif // OT_API_LOCK_STATS_ENABLE
+
 void otSysApiLock(void)
 {
+#if OT_API_LOCK_STATS_ENABLE
+    void *     caller = getCaller(__builtin_return_address(0));
+    uint64_t   start  = (uint64_t)esp_timer_get_time();
+    bool       contended;
+    uint32_t   wait;
+    BaseType_t ret;
+
+    ret       = xSemaphoreTake(sApiMutex, 0);
+    contended = (ret != pdTRUE);
+
+    if (contended)
+    {
+        ret = xSemaphoreTake(sApiMutex, portMAX_DELAY);
+    }
+
+    VerifyOrDie(ret == pdTRUE, OT_EXIT_FAILURE);
+
+    sHoldStart  = (uint64_t)esp_timer_get_time();
+    sHoldCaller = caller;
+    wait        = (uint32_t)(sHoldStart - start);
+
+    portENTER_CRITICAL(&sStatsLock);
+    sStats.mAcquisitions++;
+
+    if (contended)
+    {
+        sStats.mContentions++;
+    }
+
+    recordTime(sStats.mWaitHistogram, wait);
+
+    if (wait > sStats.mMaxWaitTime)
+    {
+        sStats.mMaxWaitTime = wait;
+    }
+    portEXIT_CRITICAL(&sStatsLock);
+#else
     BaseType_t ret = xSemaphoreTake(sApiMutex, portMAX_DELAY);
     VerifyOrDie(ret == pdTRUE, OT_EXIT_FAILURE);
+#endif
+
+    platformMainloopApiLockTaken();
 }
 
 void otSysApiUnlock(void)
 {
+#if OT_API_LOCK_STATS_ENABLE
+    uint32_t    hold   = (uint32_t)((uint64_t)esp_timer_get_time() - sHoldStart);
+    void *      caller = sHoldCaller;
+    const char *task   = pcTaskGetTaskName(NULL);
+
+    portENTER_CRITICAL(&sStatsLock);
+    recordTime(sStats.mHoldHistogram, hold);
+
+    if (hold > sStats.mMaxHoldTime)
+    {
+        sStats.mMaxHoldTime   = hold;
+        sStats.mMaxHoldCaller = caller;
+        strncpy(sStats.mMaxHoldTask, task, sizeof(sStats.mMaxHoldTask) - 1);
+        sStats.mMaxHoldTask[sizeof(sStats.mMaxHoldTask) - 1] = '\0';
+    }
+    portEXIT_CRITICAL(&sStatsLock);
+#endif
+
     xSemaphoreGive(sApiMutex);
+
+#if OT_API_LOCK_STATS_ENABLE
+    // Logged once the lock is released, the log output must not delay the other tasks any further.
+    if (OT_API_LOCK_LONG_HOLD_THRESHOLD > 0 && hold >= OT_API_LOCK_LONG_HOLD_THRESHOLD)
+    {
+        ESP_LOGW(OT_PLAT_LOG_TAG, "api lock held for %u us by %s from %p", hold, task, caller);
+    }
+#endif
+}
+
+void otSysGetApiLockStats(otSysApiLockStats *aStats)
+{
+#if OT_API_LOCK_STATS_ENABLE
+    portENTER_CRITICAL(&sStatsLock);
+    *aStats = sStats;
+    portEXIT_CRITICAL(&sStatsLock);
+#else
+    memset(aStats, 0, sizeof(*aStats));
+#endif
+}
+
+void otSysResetApiLockStats(void)
+{
+#if OT_API_LOCK_STATS_ENABLE
+    portENTER_CRITICAL(&sStatsLock);
+    memset(&sStats, 0, sizeof(sStats));
+    portEXIT_CRITICAL(&sStatsLock);
+#endif
+}
+
+bool platformApiLockIsHeld(void)
+{
+    return sApiMutex != NULL && xSemaphoreGetMutexHolder(sApiMutex) == xTaskGetCurrentTaskHandle();
 }
 
 void platformApiLockInit(void)
@@ -0,0 +1,122 @@
+/*
+ *  Copyright (c) 2020, The OpenThread Authors.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  3. Neither the name of the copyright holder nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file implements the mainloop events on a FreeRTOS event group, instead of the event file.
+ *
+ *   The platformVfsEvent* interface of src/vfs_event.c is kept, so the drivers signal their events the same way in
+ *   both mainloop modes.
+ */
+
+#include "platform-esp32.h"
+
+#include <freertos/FreeRTOS.h>
+#include <freertos/event_groups.h>
+
+#include <openthread/openthread-esp32.h>
+
+#include "error_handling.h"
+
+#if OT_MAINLOOP_EVENT_GROUP_ENABLE
+
+/**
+ * All the events the mainloop waits for.
+ */
+#define OT_EVENT_ALL                                                                                          \
+    (OT_EVENT_RADIO_UART | OT_EVENT_CLI_UART | OT_EVENT_RADIO_SPI | OT_EVENT_RADIO2_UART | OT_EVENT_ALARM_MICRO | \
+     OT_EVENT_ALARM_MILLI | OT_EVENT_MAINLOOP_BREAK | OT_EVENT_API_CALL | OT_EVENT_MAINLOOP_HANDLER_ALL)
+
+static EventGroupHandle_t sEventGroup = NULL;
+
+/**
+ * The events signaled before the current mainloop iteration.
+ */
+static uint32_t sProcessingEvents = 0;
+
+void platformVfsEventInit(void)
+{
+    sEventGroup = xEventGroupCreate();
+    VerifyOrDie(sEventGroup != NULL, OT_EXIT_FAILURE);
+}
+
+void platformVfsEventDeinit(void)
+{
+    if (sEventGroup != NULL)
+    {
+        vEventGroupDelete(sEventGroup);
+        sEventGroup = NULL;
+    }
+}
+
+void platformVfsEventUpdate(otSysMainloopContext *aMainloop)
+{
+    // There is no file to wait for.
+    OT_UNUSED_VARIABLE(aMainloop);
+}
+
+int platformVfsEventWait(const otSysMainloopContext *aMainloop)
+{
+    uint64_t   timeout = (uint64_t)aMainloop->mTimeout.tv_sec * OT_MS_PER_S +
+                       ((uint64_t)aMainloop->mTimeout.tv_usec + OT_US_PER_MS - 1) / OT_US_PER_MS;
+    TickType_t ticks   = portMAX_DELAY;
+
+    if (timeout < portMAX_DELAY / OT_MS_PER_S)
+    {
+        // Rounded up, the mainloop must not wake up before the timeout.
+        ticks = (TickType_t)((timeout + portTICK_PERIOD_MS - 1) / portTICK_PERIOD_MS);
+    }
+
+    // The bits are cleared when the events are processed.
+    return (xEventGroupWaitBits(sEventGroup, OT_EVENT_ALL, pdFALSE, pdFALSE, ticks) & OT_EVENT_ALL) != 0;
+}
+
+void platformVfsEventProcess(otInstance *aInstance, const otSysMainloopContext *aMainloop)
+{
+    OT_UNUSED_VARIABLE(aInstance);
+    OT_UNUSED_VARIABLE(aMainloop);
+
+    sProcessingEvents = xEventGroupClearBits(sEventGroup, OT_EVENT_ALL);
+}
+
+void platformVfsEventActivate(void)
+{
+    xEventGroupSetBits(sEventGroup, OT_EVENT_MAINLOOP_BREAK);
+}
+
+void platformVfsEventSignal(uint32_t aEvents)
+{
+    xEventGroupSetBits(sEventGroup, aEvents);
+}
+
+bool platformVfsEventIsSignaled(uint32_t aEvents)
+{
+    return (sProcessingEvents & aEvents) != 0;
+}
+
+#endif // OT_MAINLOOP_EVENT_GROUP_ENABLE
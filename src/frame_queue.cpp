@@ -0,0 +1,151 @@
+/*
+ *  Copyright (c) 2020, The OpenThread Authors.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  3. Neither the name of the copyright holder nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "frame_queue.hpp"
+
+#include <assert.h>
+#include <stddef.h>
+#include <string.h>
+
+#include "error_handling.h"
+
+namespace ot {
+
+namespace Esp32 {
+
+FrameQueue::FrameQueue(void)
+    : mBuffer(NULL)
+    , mSize(0)
+    , mHead(0)
+    , mTail(0)
+{
+}
+
+void FrameQueue::Init(uint8_t *aBuffer, uint32_t aSize)
+{
+    assert(aSize != 0 && (aSize & (aSize - 1)) == 0);
+
+    mBuffer = aBuffer;
+    mSize   = aSize;
+    Clear();
+}
+
+void FrameQueue::Clear(void)
+{
+    mHead = 0;
+    mTail = 0;
+}
+
+bool FrameQueue::Push(const uint8_t *aFrame, uint16_t aLength, uint64_t aTime)
+{
+    bool     pushed = false;
+    uint32_t tail   = mTail;
+    uint32_t head   = __atomic_load_n(&mHead, __ATOMIC_ACQUIRE);
+    Header   header;
+
+    if (mSize - (tail - head) >= sizeof(header) + aLength)
+    {
+        header.mTime   = aTime;
+        header.mLength = aLength;
+        CopyIn(tail, &header, sizeof(header));
+        CopyIn(tail + sizeof(header), aFrame, aLength);
+
+        // Publish the frame once it has been written entirely.
+        __atomic_store_n(&mTail, tail + sizeof(header) + aLength, __ATOMIC_RELEASE);
+        pushed = true;
+    }
+
+    return pushed;
+}
+
+otError FrameQueue::Pop(Hdlc::FrameWritePointer &aFrame, uint64_t &aTime)
+{
+    otError  error = OT_ERROR_NONE;
+    uint32_t head  = mHead;
+    uint32_t tail  = __atomic_load_n(&mTail, __ATOMIC_ACQUIRE);
+    Header   header;
+
+    VerifyOrExit(head != tail, error = OT_ERROR_NOT_FOUND);
+
+    CopyOut(head, &header, sizeof(header));
+    aTime = header.mTime;
+
+    if (aFrame.CanWrite(header.mLength))
+    {
+        for (uint32_t i = 0; i < header.mLength; i++)
+        {
+            aFrame.WriteByte(mBuffer[GetIndex(head + sizeof(header) + i)]);
+        }
+    }
+    else
+    {
+        error = OT_ERROR_NO_BUFS;
+    }
+
+    // Release the storage to the producer once the frame has been copied out.
+    __atomic_store_n(&mHead, head + sizeof(header) + header.mLength, __ATOMIC_RELEASE);
+
+exit:
+    return error;
+}
+
+void FrameQueue::CopyIn(uint32_t aPosition, const void *aData, uint32_t aLength)
+{
+    uint32_t index  = GetIndex(aPosition);
+    uint32_t toWrap = mSize - index;
+
+    if (aLength <= toWrap)
+    {
+        memcpy(mBuffer + index, aData, aLength);
+    }
+    else
+    {
+        memcpy(mBuffer + index, aData, toWrap);
+        memcpy(mBuffer, static_cast<const uint8_t *>(aData) + toWrap, aLength - toWrap);
+    }
+}
+
+void FrameQueue::CopyOut(uint32_t aPosition, void *aData, uint32_t aLength) const
+{
+    uint32_t index  = GetIndex(aPosition);
+    uint32_t toWrap = mSize - index;
+
+    if (aLength <= toWrap)
+    {
+        memcpy(aData, mBuffer + index, aLength);
+    }
+    else
+    {
+        memcpy(aData, mBuffer + index, toWrap);
+        memcpy(static_cast<uint8_t *>(aData) + toWrap, mBuffer, aLength - toWrap);
+    }
+}
+
+} // namespace Esp32
+
+} // namespace ot
@@ -0,0 +1,128 @@
+/*
+ *  Copyright (c) 2020, The OpenThread Authors.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  3. Neither the name of the copyright holder nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef OT_ESP32_FRAME_QUEUE_HPP_
+#define OT_ESP32_FRAME_QUEUE_HPP_
+
+#include <stdint.h>
+
+#include <openthread/error.h>
+
+#include "lib/hdlc/hdlc.hpp"
+
+namespace ot {
+
+namespace Esp32 {
+
+/**
+ * This class implements a lock-free queue of frames between one producer and one consumer.
+ *
+ * The producer and the consumer may run on different cores. Each frame is stored with its length and a timestamp,
+ * and becomes visible to the consumer only once it has been written entirely.
+ *
+ */
+class FrameQueue
+{
+public:
+    /**
+     * This constructor initializes the object without any storage.
+     *
+     */
+    FrameQueue(void);
+
+    /**
+     * This method attaches storage to the queue and clears it.
+     *
+     * @param[in] aBuffer  A pointer to the storage.
+     * @param[in] aSize    The size of @p aBuffer in bytes, MUST be a power of two.
+     *
+     */
+    void Init(uint8_t *aBuffer, uint32_t aSize);
+
+    /**
+     * This method discards all frames in the queue.
+     *
+     * This method MUST NOT be called while the producer or the consumer is using the queue.
+     *
+     */
+    void Clear(void);
+
+    /**
+     * This method appends a frame to the queue, it is only called by the producer.
+     *
+     * @param[in] aFrame   A pointer to the frame.
+     * @param[in] aLength  The length of the frame in bytes.
+     * @param[in] aTime    The timestamp of the frame.
+     *
+     * @retval TRUE   The frame has been queued.
+     * @retval FALSE  The queue is full, the frame has been dropped.
+     *
+     */
+    bool Push(const uint8_t *aFrame, uint16_t aLength, uint64_t aTime);
+
+    /**
+     * This method removes the oldest frame from the queue, it is only called by the consumer.
+     *
+     * @param[out] aFrame  The frame buffer the frame is written to.
+     * @param[out] aTime   The timestamp of the frame.
+     *
+     * @retval OT_ERROR_NONE       The frame has been written to @p aFrame.
+     * @retval OT_ERROR_NOT_FOUND  The queue is empty.
+     * @retval OT_ERROR_NO_BUFS    The frame does not fit in @p aFrame, it has been dropped.
+     *
+     */
+    otError Pop(Hdlc::FrameWritePointer &aFrame, uint64_t &aTime);
+
+private:
+    struct Header
+    {
+        uint64_t mTime;
+        uint16_t mLength;
+    };
+
+    uint32_t GetIndex(uint32_t aPosition) const { return aPosition & (mSize - 1); }
+    void     CopyIn(uint32_t aPosition, const void *aData, uint32_t aLength);
+    void     CopyOut(uint32_t aPosition, void *aData, uint32_t aLength) const;
+
+    uint8_t *mBuffer;
+    uint32_t mSize;
+
+    // Free running positions, `mHead` is only written by the consumer and `mTail` only by the producer.
+    uint32_t mHead;
+    uint32_t mTail;
+
+    // Non-copyable, intentionally not implemented.
+    FrameQueue(const FrameQueue &);
+    FrameQueue &operator=(const FrameQueue &);
+};
+
+} // namespace Esp32
+
+} // namespace ot
+
+#endif // OT_ESP32_FRAME_QUEUE_HPP_
@@ -0,0 +1,386 @@
+/*
+ *  Copyright (c) 2020, The OpenThread Authors.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  3. Neither the name of the copyright holder nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "hdlc_codec.hpp"
+
+#include <assert.h>
+#include <stddef.h>
+#include <string.h>
+
+#include <esp_attr.h>
+
+#include "error_handling.h"
+
+namespace ot {
+
+namespace Esp32 {
+
+namespace {
+
+enum
+{
+    kFlagXOn        = 0x11,
+    kFlagXOff       = 0x13,
+    kFlagSequence   = 0x7e,
+    kEscapeSequence = 0x7d,
+    kFlagSpecial    = 0xf8,
+    kEscapeXor      = 0x20,
+};
+
+const uint32_t kWordOnes = 0x01010101UL;
+const uint32_t kWordHigh = 0x80808080UL;
+
+inline uint32_t WordHasByte(uint32_t aWord, uint8_t aByte)
+{
+    uint32_t value = aWord ^ (kWordOnes * aByte);
+
+    return (value - kWordOnes) & ~value & kWordHigh;
+}
+
+inline bool DecoderNeedsAttention(uint8_t aByte)
+{
+    return aByte == kFlagSequence || aByte == kEscapeSequence;
+}
+
+inline bool EncoderNeedsEscape(uint8_t aByte)
+{
+    return aByte == kFlagSequence || aByte == kEscapeSequence || aByte == kFlagXOn || aByte == kFlagXOff ||
+           aByte == kFlagSpecial;
+}
+
+inline bool DecoderWordNeedsAttention(uint32_t aWord)
+{
+    return (WordHasByte(aWord, kFlagSequence) | WordHasByte(aWord, kEscapeSequence)) != 0;
+}
+
+inline bool EncoderWordNeedsEscape(uint32_t aWord)
+{
+    return (WordHasByte(aWord, kFlagSequence) | WordHasByte(aWord, kEscapeSequence) | WordHasByte(aWord, kFlagXOn) |
+            WordHasByte(aWord, kFlagXOff) | WordHasByte(aWord, kFlagSpecial)) != 0;
+}
+
+/**
+ * This function returns the number of leading bytes which can be passed through as they are.
+ *
+ * Bytes are checked one at a time until the pointer is word aligned, then a word at a time.
+ *
+ */
+template <bool (*ByteCheck)(uint8_t), bool (*WordCheck)(uint32_t)>
+IRAM_ATTR uint16_t ScanPlainRun(const uint8_t *aData, uint16_t aLength)
+{
+    uint16_t length = 0;
+
+    while (length < aLength && (reinterpret_cast<uintptr_t>(aData + length) & (sizeof(uint32_t) - 1)) != 0)
+    {
+        VerifyOrExit(!ByteCheck(aData[length]), OT_NOOP);
+        length++;
+    }
+
+    while (static_cast<uint16_t>(aLength - length) >= sizeof(uint32_t))
+    {
+        uint32_t word;
+
+        memcpy(&word, aData + length, sizeof(word));
+
+        if (WordCheck(word))
+        {
+            break;
+        }
+
+        length += sizeof(uint32_t);
+    }
+
+    while (length < aLength && !ByteCheck(aData[length]))
+    {
+        length++;
+    }
+
+exit:
+    return length;
+}
+
+} // namespace
+
+uint16_t HdlcFcs::sTable[4][256];
+
+void HdlcFcs::Init(void)
+{
+    VerifyOrExit(sTable[0][1] == 0, OT_NOOP);
+
+    for (uint16_t i = 0; i < 256; i++)
+    {
+        uint16_t fcs = i;
+
+        for (uint8_t bit = 0; bit < 8; bit++)
+        {
+            fcs = (fcs & 1) ? static_cast<uint16_t>((fcs >> 1) ^ 0x8408) : static_cast<uint16_t>(fcs >> 1);
+        }
+
+        sTable[0][i] = fcs;
+    }
+
+    for (uint8_t slice = 1; slice < 4; slice++)
+    {
+        for (uint16_t i = 0; i < 256; i++)
+        {
+            uint16_t prev = sTable[slice - 1][i];
+
+            sTable[slice][i] = static_cast<uint16_t>((prev >> 8) ^ sTable[0][prev & 0xff]);
+        }
+    }
+
+exit:
+    return;
+}
+
+IRAM_ATTR uint16_t HdlcFcs::Update(uint16_t aFcs, const uint8_t *aData, uint16_t aLength)
+{
+    while (aLength >= 4)
+    {
+        aFcs = sTable[3][(aFcs ^ aData[0]) & 0xff] ^ sTable[2][((aFcs >> 8) ^ aData[1]) & 0xff] ^
+               sTable[1][aData[2]] ^ sTable[0][aData[3]];
+        aData += 4;
+        aLength -= 4;
+    }
+
+    while (aLength-- > 0)
+    {
+        aFcs = Update(aFcs, *aData++);
+    }
+
+    return aFcs;
+}
+
+HdlcEncoder::HdlcEncoder(void)
+    : mFcs(HdlcFcs::kInitFcs)
+{
+    HdlcFcs::Init();
+}
+
+uint16_t HdlcEncoder::BeginFrame(uint8_t *aOutput)
+{
+    mFcs       = HdlcFcs::kInitFcs;
+    aOutput[0] = kFlagSequence;
+
+    return 1;
+}
+
+IRAM_ATTR uint16_t HdlcEncoder::Encode(const uint8_t *aInput,
+                                       uint16_t       aInputLength,
+                                       uint8_t *      aOutput,
+                                       uint16_t &     aOutputLength)
+{
+    uint16_t consumed = 0;
+    uint16_t written  = 0;
+
+    while (consumed < aInputLength && written < aOutputLength)
+    {
+        uint16_t available = static_cast<uint16_t>(aInputLength - consumed);
+        uint16_t space     = static_cast<uint16_t>(aOutputLength - written);
+        uint16_t run;
+
+        run = ScanPlainRun<EncoderNeedsEscape, EncoderWordNeedsEscape>(aInput + consumed,
+                                                                       (available < space) ? available : space);
+
+        if (run > 0)
+        {
+            memcpy(aOutput + written, aInput + consumed, run);
+            mFcs = HdlcFcs::Update(mFcs, aInput + consumed, run);
+            consumed += run;
+            written += run;
+            continue;
+        }
+
+        // The next byte needs escaping.
+        VerifyOrExit(space >= 2, OT_NOOP);
+
+        mFcs               = HdlcFcs::Update(mFcs, aInput[consumed]);
+        aOutput[written++] = kEscapeSequence;
+        aOutput[written++] = aInput[consumed++] ^ kEscapeXor;
+    }
+
+exit:
+    aOutputLength = written;
+    return consumed;
+}
+
+uint16_t HdlcEncoder::EndFrame(uint8_t *aOutput)
+{
+    uint16_t written = 0;
+    uint16_t fcs     = static_cast<uint16_t>(mFcs ^ 0xffff);
+    uint8_t  fcsBytes[HdlcFcs::kFcsSize];
+
+    fcsBytes[0] = static_cast<uint8_t>(fcs & 0xff);
+    fcsBytes[1] = static_cast<uint8_t>(fcs >> 8);
+
+    for (uint8_t i = 0; i < sizeof(fcsBytes); i++)
+    {
+        if (EncoderNeedsEscape(fcsBytes[i]))
+        {
+            aOutput[written++] = kEscapeSequence;
+            aOutput[written++] = fcsBytes[i] ^ kEscapeXor;
+        }
+        else
+        {
+            aOutput[written++] = fcsBytes[i];
+        }
+    }
+
+    aOutput[written++] = kFlagSequence;
+
+    return written;
+}
+
+HdlcDecoder::HdlcDecoder(ot::Hdlc::FrameWritePointer &aFrameWritePointer,
+                         FrameHandler                  aFrameHandler,
+                         void *                        aContext)
+    : mState(kStateNoSync)
+    , mWritePointer(aFrameWritePointer)
+    , mFrameHandler(aFrameHandler)
+    , mContext(aContext)
+    , mDecodedLength(0)
+    , mFcs(HdlcFcs::kInitFcs)
+{
+    HdlcFcs::Init();
+}
+
+void HdlcDecoder::Reset(void)
+{
+    // Drop the bytes of the partially decoded frame from the frame buffer.
+    mWritePointer.UndoLastWrites(mDecodedLength);
+
+    mState         = kStateNoSync;
+    mDecodedLength = 0;
+    mFcs           = HdlcFcs::kInitFcs;
+}
+
+bool HdlcDecoder::WriteDecoded(const uint8_t *aData, uint16_t aLength)
+{
+    bool written = mWritePointer.CanWrite(aLength);
+
+    if (written)
+    {
+        for (uint16_t i = 0; i < aLength; i++)
+        {
+            mWritePointer.WriteByte(aData[i]);
+        }
+
+        mFcs = HdlcFcs::Update(mFcs, aData, aLength);
+        mDecodedLength += aLength;
+    }
+    else
+    {
+        // The frame handler discards the partial frame.
+        mFrameHandler(mContext, OT_ERROR_NO_BUFS);
+        mState         = kStateNoSync;
+        mDecodedLength = 0;
+    }
+
+    return written;
+}
+
+IRAM_ATTR void HdlcDecoder::Decode(const uint8_t *aData, uint16_t aLength)
+{
+    const uint8_t *end = aData + aLength;
+
+    while (aData < end)
+    {
+        uint8_t byte;
+
+        if (mState == kStateSync)
+        {
+            uint16_t run =
+                ScanPlainRun<DecoderNeedsAttention, DecoderWordNeedsAttention>(aData, static_cast<uint16_t>(end - aData));
+
+            if (run > 0)
+            {
+                WriteDecoded(aData, run);
+                aData += run;
+                continue;
+            }
+        }
+
+        byte = *aData++;
+
+        switch (mState)
+        {
+        case kStateNoSync:
+            if (byte == kFlagSequence)
+            {
+                mState         = kStateSync;
+                mDecodedLength = 0;
+                mFcs           = HdlcFcs::kInitFcs;
+            }
+
+            break;
+
+        case kStateSync:
+            if (byte == kEscapeSequence)
+            {
+                mState = kStateEscaped;
+            }
+            else
+            {
+                assert(byte == kFlagSequence);
+
+                if (mDecodedLength > 0)
+                {
+                    otError error = OT_ERROR_PARSE;
+
+                    if ((mDecodedLength >= HdlcFcs::kFcsSize) && (mFcs == HdlcFcs::kGoodFcs))
+                    {
+                        // Remove the FCS from the frame.
+                        mWritePointer.UndoLastWrites(HdlcFcs::kFcsSize);
+                        error = OT_ERROR_NONE;
+                    }
+
+                    mFrameHandler(mContext, error);
+                }
+
+                mDecodedLength = 0;
+                mFcs           = HdlcFcs::kInitFcs;
+            }
+
+            break;
+
+        case kStateEscaped:
+            byte ^= kEscapeXor;
+
+            if (WriteDecoded(&byte, sizeof(byte)))
+            {
+                mState = kStateSync;
+            }
+
+            break;
+        }
+    }
+}
+
+} // namespace Esp32
+
+} // namespace ot
@@ -0,0 +1,211 @@
+/*
+ *  Copyright (c) 2020, The OpenThread Authors.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  3. Neither the name of the copyright holder nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef OT_ESP32_HDLC_CODEC_HPP_
+#define OT_ESP32_HDLC_CODEC_HPP_
+
+#include <stdint.h>
+
+#include <openthread/error.h>
+
+#include "lib/hdlc/hdlc.hpp"
+
+namespace ot {
+
+namespace Esp32 {
+
+/**
+ * This class implements the HDLC-lite frame check sequence (CRC-16/X.25) with slicing-by-4 tables.
+ *
+ */
+class HdlcFcs
+{
+public:
+    enum
+    {
+        kInitFcs = 0xffff, ///< Initial FCS value.
+        kGoodFcs = 0xf0b8, ///< FCS value over a frame including its FCS.
+        kFcsSize = 2,      ///< Size of the FCS in a frame.
+    };
+
+    /**
+     * This static method builds the lookup tables, it MUST be called before any other method is used.
+     *
+     * Calling it more than once is harmless.
+     *
+     */
+    static void Init(void);
+
+    /**
+     * This static method updates an FCS with a block of bytes.
+     *
+     * @param[in] aFcs     The current FCS.
+     * @param[in] aData    A pointer to the bytes.
+     * @param[in] aLength  The number of bytes.
+     *
+     * @returns The updated FCS.
+     *
+     */
+    static uint16_t Update(uint16_t aFcs, const uint8_t *aData, uint16_t aLength);
+
+    /**
+     * This static method updates an FCS with a single byte.
+     *
+     * @param[in] aFcs   The current FCS.
+     * @param[in] aByte  The byte.
+     *
+     * @returns The updated FCS.
+     *
+     */
+    static uint16_t Update(uint16_t aFcs, uint8_t aByte)
+    {
+        return static_cast<uint16_t>((aFcs >> 8) ^ sTable[0][(aFcs ^ aByte) & 0xff]);
+    }
+
+private:
+    static uint16_t sTable[4][256];
+};
+
+/**
+ * This class implements an HDLC-lite encoder writing into caller provided chunks.
+ *
+ * The output is identical to `ot::Hdlc::Encoder`, but runs of bytes that need no escaping are found a word at a time
+ * and copied in bulk.
+ *
+ */
+class HdlcEncoder
+{
+public:
+    enum
+    {
+        kMaxEndFrameSize = 5, ///< Maximum number of bytes written by `EndFrame()`.
+    };
+
+    /**
+     * This constructor initializes the object.
+     *
+     */
+    HdlcEncoder(void);
+
+    /**
+     * This method begins a new frame.
+     *
+     * @param[out] aOutput  A pointer to a buffer of at least one byte.
+     *
+     * @returns The number of bytes written to @p aOutput.
+     *
+     */
+    uint16_t BeginFrame(uint8_t *aOutput);
+
+    /**
+     * This method encodes as much of the input as fits into the output buffer.
+     *
+     * @param[in]    aInput         A pointer to the bytes to encode.
+     * @param[in]    aInputLength   The number of bytes to encode.
+     * @param[out]   aOutput        A pointer to the output buffer.
+     * @param[inout] aOutputLength  On input the size of @p aOutput, on output the number of bytes written.
+     *
+     * @returns The number of input bytes consumed.
+     *
+     */
+    uint16_t Encode(const uint8_t *aInput, uint16_t aInputLength, uint8_t *aOutput, uint16_t &aOutputLength);
+
+    /**
+     * This method ends the current frame.
+     *
+     * @param[out] aOutput  A pointer to a buffer of at least `kMaxEndFrameSize` bytes.
+     *
+     * @returns The number of bytes written to @p aOutput.
+     *
+     */
+    uint16_t EndFrame(uint8_t *aOutput);
+
+private:
+    uint16_t mFcs;
+};
+
+/**
+ * This class implements an HDLC-lite decoder.
+ *
+ * It is a drop-in replacement of `ot::Hdlc::Decoder`, runs of bytes without flag or escape are found a word at a time
+ * and their FCS is computed in bulk.
+ *
+ */
+class HdlcDecoder
+{
+public:
+    typedef ot::Hdlc::Decoder::FrameHandler FrameHandler;
+
+    /**
+     * This constructor initializes the decoder.
+     *
+     * @param[in] aFrameWritePointer  The frame write pointer used to store the decoded frames.
+     * @param[in] aFrameHandler       The frame handler callback function pointer.
+     * @param[in] aContext            A pointer to arbitrary context information.
+     *
+     */
+    HdlcDecoder(ot::Hdlc::FrameWritePointer &aFrameWritePointer, FrameHandler aFrameHandler, void *aContext);
+
+    /**
+     * This method feeds received bytes into the decoder.
+     *
+     * @param[in]  aData    A pointer to the received bytes.
+     * @param[in]  aLength  The number of received bytes.
+     *
+     */
+    void Decode(const uint8_t *aData, uint16_t aLength);
+
+    /**
+     * This method resets the decoder, the bytes of a partially decoded frame are removed from the frame buffer.
+     *
+     */
+    void Reset(void);
+
+private:
+    enum State
+    {
+        kStateNoSync,
+        kStateSync,
+        kStateEscaped,
+    };
+
+    bool WriteDecoded(const uint8_t *aData, uint16_t aLength);
+
+    State                         mState;
+    ot::Hdlc::FrameWritePointer &mWritePointer;
+    FrameHandler                  mFrameHandler;
+    void *                        mContext;
+    uint16_t                      mDecodedLength;
+    uint16_t                      mFcs;
+};
+
+} // namespace Esp32
+
+} // namespace ot
+
+#endif // OT_ESP32_HDLC_CODEC_HPP_
@@ -0,0 +1,152 @@
+/*
+ *  Copyright (c) 2020, The OpenThread Authors.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  3. Neither the name of the copyright holder nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file implements the application handlers of the mainloop.
+ */
+
+#include "platform-esp32.h"
+
+#include <stddef.h>
+#include <sys/select.h>
+
+#include <openthread/openthread-esp32.h>
+
+#include "error_handling.h"
+
+static const otSysMainloopHandler *sHandlers[OT_MAINLOOP_HANDLER_MAX];
+
+static int findHandler(const otSysMainloopHandler *aHandler)
+{
+    int index = -1;
+
+    for (int i = 0; i < OT_MAINLOOP_HANDLER_MAX; i++)
+    {
+        if (sHandlers[i] == aHandler)
+        {
+            index = i;
+            break;
+        }
+    }
+
+    return index;
+}
+
+otError otSysMainloopAddHandler(const otSysMainloopHandler *aHandler)
+{
+    otError error = OT_ERROR_NONE;
+    int     index;
+
+    VerifyOrExit(findHandler(aHandler) < 0, error = OT_ERROR_ALREADY);
+#if OT_MAINLOOP_EVENT_GROUP_ENABLE
+    VerifyOrExit(aHandler->mFd < 0, error = OT_ERROR_INVALID_ARGS);
+#endif
+
+    index = findHandler(NULL);
+    VerifyOrExit(index >= 0, error = OT_ERROR_NO_BUFS);
+
+    sHandlers[index] = aHandler;
+
+exit:
+    return error;
+}
+
+otError otSysMainloopRemoveHandler(const otSysMainloopHandler *aHandler)
+{
+    otError error = OT_ERROR_NONE;
+    int     index = findHandler(aHandler);
+
+    VerifyOrExit(aHandler != NULL && index >= 0, error = OT_ERROR_NOT_FOUND);
+
+    sHandlers[index] = NULL;
+
+exit:
+    return error;
+}
+
+void otSysMainloopSignal(const otSysMainloopHandler *aHandler)
+{
+    int index = findHandler(aHandler);
+
+    if (aHandler != NULL && index >= 0)
+    {
+        platformVfsEventSignal(OT_EVENT_MAINLOOP_HANDLER(index));
+    }
+}
+
+void platformMainloopHandlerUpdate(otSysMainloopContext *aMainloop)
+{
+    for (int i = 0; i < OT_MAINLOOP_HANDLER_MAX; i++)
+    {
+        const otSysMainloopHandler *handler = sHandlers[i];
+
+        if (handler == NULL)
+        {
+            continue;
+        }
+
+#if !OT_MAINLOOP_EVENT_GROUP_ENABLE
+        if (handler->mFd >= 0)
+        {
+            FD_SET(handler->mFd, &aMainloop->mReadFdSet);
+
+            if (handler->mFd > aMainloop->mMaxFd)
+            {
+                aMainloop->mMaxFd = handler->mFd;
+            }
+        }
+#endif
+
+        if (handler->mUpdate != NULL)
+        {
+            handler->mUpdate(handler->mContext, aMainloop);
+        }
+    }
+}
+
+void platformMainloopHandlerProcess(const otSysMainloopContext *aMainloop)
+{
+    for (int i = 0; i < OT_MAINLOOP_HANDLER_MAX; i++)
+    {
+        const otSysMainloopHandler *handler = sHandlers[i];
+        bool                        signaled;
+
+        if (handler == NULL || handler->mProcess == NULL)
+        {
+            continue;
+        }
+
+        signaled = platformVfsEventIsSignaled(OT_EVENT_MAINLOOP_HANDLER(i));
+#if !OT_MAINLOOP_EVENT_GROUP_ENABLE
+        signaled = signaled || (handler->mFd >= 0 && FD_ISSET(handler->mFd, &aMainloop->mReadFdSet));
+#endif
+
+        handler->mProcess(handler->mContext, aMainloop, signaled);
+    }
+}
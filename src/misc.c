@@ -28,16 +28,178 @@
 
 #include "platform-esp32.h"
 
+#include <string.h>
 #include <unistd.h>
 
 #include <esp_log.h>
+#include <esp_pm.h>
+#include <esp_sleep.h>
+#include <esp_timer.h>
+#include <sdkconfig.h>
+
+#if CONFIG_PM_ENABLE
+#include <esp32/pm.h>
+#endif
 
 #include <openthread/platform/misc.h>
 
+#include "error_handling.h"
+
 static otPlatResetReason   sPlatResetReason = OT_PLAT_RESET_REASON_POWER_ON;
 bool                       gPlatformPseudoResetWasRequested;
 static otPlatMcuPowerState gPlatMcuPowerState = OT_PLAT_MCU_POWER_STATE_ON;
 
+#if CONFIG_PM_ENABLE
+/**
+ * Held unless the mainloop waits for events in the low power state with all radios idle, so that the chip only enters
+ * light sleep then. It keeps the APB clock at its maximum, the radio uarts are clocked by it.
+ */
+static esp_pm_lock_handle_t sActiveLock = NULL;
+static bool                 sActiveLockHeld;
+#endif
+
+static otSysPowerStats sPowerStats;
+static uint64_t        sIntervalStart;
+static uint64_t        sLowPowerStart;
+static uint64_t        sPollStart;
+static bool            sPollIdle;
+
+#if CONFIG_PM_ENABLE
+static void setActiveLock(bool aHeld)
+{
+    VerifyOrExit(sActiveLock != NULL && aHeld != sActiveLockHeld, OT_NOOP);
+
+    ESP_ERROR_CHECK(aHeld ? esp_pm_lock_acquire(sActiveLock) : esp_pm_lock_release(sActiveLock));
+    sActiveLockHeld = aHeld;
+
+exit:
+    return;
+}
+#endif
+
+/**
+ * This function accounts the time spent in the low power state since the last call.
+ *
+ */
+static void updateLowPowerTime(uint64_t aNow)
+{
+    if (gPlatMcuPowerState == OT_PLAT_MCU_POWER_STATE_LOW_POWER)
+    {
+        sPowerStats.mLowPowerTime += aNow - sLowPowerStart;
+    }
+
+    sLowPowerStart = aNow;
+}
+
+void platformPowerInit(void)
+{
+#if CONFIG_PM_ENABLE
+    esp_pm_config_esp32_t pmConfig = {
+        .max_freq_mhz = OT_PM_MAX_FREQ_MHZ,
+        .min_freq_mhz = OT_PM_MIN_FREQ_MHZ,
+#if CONFIG_FREERTOS_USE_TICKLESS_IDLE
+        .light_sleep_enable = true,
+#endif
+    };
+
+    ESP_ERROR_CHECK(esp_pm_configure(&pmConfig));
+    ESP_ERROR_CHECK(esp_pm_lock_create(ESP_PM_APB_FREQ_MAX, 0, "ot_active", &sActiveLock));
+
+    // The lock is only released while the mainloop waits for events.
+    setActiveLock(true);
+
+    // Bytes received while asleep are lost, the peer has to send a few more once it sees no response.
+    ESP_ERROR_CHECK(uart_set_wakeup_threshold(OT_CLI_UART_NUM, OT_UART_WAKEUP_THRESHOLD));
+    ESP_ERROR_CHECK(esp_sleep_enable_uart_wakeup(OT_CLI_UART_NUM));
+#if OT_RADIO_SPI_ENABLE
+    // The RCP interrupt is only made a wakeup source while the chip may sleep, see platformPowerPollBegin().
+    ESP_ERROR_CHECK(esp_sleep_enable_gpio_wakeup());
+#else
+    // Only UART0 and UART1 can wake up the chip, a second RCP on UART2 keeps waiting for another wakeup source.
+    ESP_ERROR_CHECK(uart_set_wakeup_threshold(OT_RADIO_UART_NUM, OT_UART_WAKEUP_THRESHOLD));
+    ESP_ERROR_CHECK(esp_sleep_enable_uart_wakeup(OT_RADIO_UART_NUM));
+#endif
+#endif // CONFIG_PM_ENABLE
+
+    otSysResetPowerStats();
+}
+
+void platformPowerDeinit(void)
+{
+#if CONFIG_PM_ENABLE
+    setActiveLock(false);
+    ESP_ERROR_CHECK(esp_pm_lock_delete(sActiveLock));
+    sActiveLock = NULL;
+#endif
+}
+
+void platformPowerPollBegin(void)
+{
+    // The chip must not sleep through a transmission or while the RCP may send a frame, the uart would lose bytes.
+    sPollStart = (uint64_t)esp_timer_get_time();
+    sPollIdle  = (gPlatMcuPowerState == OT_PLAT_MCU_POWER_STATE_LOW_POWER) && platformRadioIsIdle();
+
+#if CONFIG_PM_ENABLE
+    setActiveLock(!sPollIdle);
+
+#if OT_RADIO_SPI_ENABLE
+    if (!sActiveLockHeld)
+    {
+        // Only a level interrupt wakes up the chip. The interrupt handler masks the line once it fires, so that it does
+        // not fire again and again while the RCP keeps its interrupt asserted. The line is masked while its type
+        // changes, the interrupt handler can not race with the driver.
+        ESP_ERROR_CHECK(gpio_intr_disable(OT_RADIO_SPI_INT));
+        ESP_ERROR_CHECK(gpio_wakeup_enable(OT_RADIO_SPI_INT, GPIO_INTR_LOW_LEVEL));
+        ESP_ERROR_CHECK(gpio_intr_enable(OT_RADIO_SPI_INT));
+    }
+#endif
+#endif
+}
+
+void platformPowerPollEnd(void)
+{
+#if CONFIG_PM_ENABLE
+#if OT_RADIO_SPI_ENABLE
+    if (!sActiveLockHeld)
+    {
+        // The SPI driver expects the falling edge interrupt, the wakeup changed the interrupt type. An assertion seen
+        // while the line was masked is found by the SPI driver sampling the line.
+        ESP_ERROR_CHECK(gpio_intr_disable(OT_RADIO_SPI_INT));
+        ESP_ERROR_CHECK(gpio_wakeup_disable(OT_RADIO_SPI_INT));
+        ESP_ERROR_CHECK(gpio_set_intr_type(OT_RADIO_SPI_INT, GPIO_INTR_NEGEDGE));
+        ESP_ERROR_CHECK(gpio_intr_enable(OT_RADIO_SPI_INT));
+    }
+#endif
+
+    // Spinel transactions started by the mainloop wait for the RCP outside of the poll, they run with the lock held.
+    setActiveLock(true);
+#endif
+
+    VerifyOrExit(sPollIdle, OT_NOOP);
+
+    sPowerStats.mIdleTime += (uint64_t)esp_timer_get_time() - sPollStart;
+    sPowerStats.mIdleWaits++;
+
+exit:
+    return;
+}
+
+void otSysGetPowerStats(otSysPowerStats *aStats)
+{
+    uint64_t now = (uint64_t)esp_timer_get_time();
+
+    updateLowPowerTime(now);
+    sPowerStats.mIntervalTime = now - sIntervalStart;
+    *aStats                   = sPowerStats;
+}
+
+void otSysResetPowerStats(void)
+{
+    memset(&sPowerStats, 0, sizeof(sPowerStats));
+    sIntervalStart = (uint64_t)esp_timer_get_time();
+    sLowPowerStart = sIntervalStart;
+}
+
 void otPlatReset(otInstance *aInstance)
 {
     OT_UNUSED_VARIABLE(aInstance);
@@ -65,6 +227,10 @@ otError otPlatSetMcuPowerState(otInstance *aInstance, otPlatMcuPowerState aState
     {
     case OT_PLAT_MCU_POWER_STATE_ON:
     case OT_PLAT_MCU_POWER_STATE_LOW_POWER:
+        VerifyOrExit(aState != gPlatMcuPowerState, OT_NOOP);
+        updateLowPowerTime((uint64_t)esp_timer_get_time());
+
+        // The active lock is updated when the mainloop waits for events next, it is held until then.
         gPlatMcuPowerState = aState;
         break;
 
@@ -73,6 +239,7 @@ otError otPlatSetMcuPowerState(otInstance *aInstance, otPlatMcuPowerState aState
         break;
     }
 
+exit:
     return error;
 }
 
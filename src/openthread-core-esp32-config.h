@@ -55,6 +55,14 @@
  */
 #define OPENTHREAD_CONFIG_PLATFORM_FLASH_API_ENABLE 1
 
+/**
+ * @def OPENTHREAD_CONFIG_PLATFORM_USEC_TIMER_ENABLE
+ *
+ * Define to 1 if you want to enable microsecond backoff timer implemented in platform.
+ *
+ */
+#define OPENTHREAD_CONFIG_PLATFORM_USEC_TIMER_ENABLE 1
+
 /**
  * @def OPENTHREAD_CONFIG_LOG_OUTPUT
  *
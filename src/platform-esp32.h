@@ -33,6 +33,12 @@
 #include <time.h>
 
 #include <driver/gpio.h>
+#include <driver/spi_master.h>
+#include <driver/uart.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#include <freertos/task.h>
+#include <sdkconfig.h>
 
 #include <openthread/instance.h>
 
@@ -80,6 +86,22 @@
 #define OT_RADIO_UART_RXD (GPIO_NUM_5)
 #endif
 
+/**
+ * The default RTS pin of the radio uart, only used with hardware flow control.
+ *
+ */
+#ifndef OT_RADIO_UART_RTS
+#define OT_RADIO_UART_RTS (UART_PIN_NO_CHANGE)
+#endif
+
+/**
+ * The default CTS pin of the radio uart, only used with hardware flow control.
+ *
+ */
+#ifndef OT_RADIO_UART_CTS
+#define OT_RADIO_UART_CTS (UART_PIN_NO_CHANGE)
+#endif
+
 /**
  * The uart used by radio spinel.
  *
@@ -88,6 +110,291 @@
 #define OT_RADIO_UART_NUM (UART_NUM_1)
 #endif
 
+/**
+ * The baud rate of the radio uart after reset.
+ *
+ */
+#ifndef OT_RADIO_UART_BAUD_RATE
+#define OT_RADIO_UART_BAUD_RATE 115200
+#endif
+
+/**
+ * The hardware flow control mode of the radio uart.
+ *
+ * Set to UART_HW_FLOWCTRL_CTS_RTS together with OT_RADIO_UART_RTS and OT_RADIO_UART_CTS
+ * to enable RTS/CTS flow control.
+ *
+ */
+#ifndef OT_RADIO_UART_FLOW_CTRL
+#define OT_RADIO_UART_FLOW_CTRL (UART_HW_FLOWCTRL_DISABLE)
+#endif
+
+/**
+ * The RX FIFO level at which the radio uart deasserts RTS, only used with hardware flow control.
+ *
+ */
+#ifndef OT_RADIO_UART_RX_FLOW_CTRL_THRESH
+#define OT_RADIO_UART_RX_FLOW_CTRL_THRESH (UART_FIFO_LEN - 8)
+#endif
+
+/**
+ * The number of Radio Co-processors (RCPs) connected to the host.
+ *
+ * Each OpenThread instance drives its own RCP, the instances are mapped to RCPs in the order they start using the
+ * radio. The second RCP is connected to the OT_RADIO2_UART_NUM uart.
+ *
+ */
+#ifndef OT_RADIO_NUM
+#define OT_RADIO_NUM 1
+#endif
+
+/**
+ * The uart used by the second RCP.
+ *
+ */
+#ifndef OT_RADIO2_UART_NUM
+#define OT_RADIO2_UART_NUM (UART_NUM_2)
+#endif
+
+/**
+ * The default TXD pin of the second radio uart.
+ *
+ */
+#ifndef OT_RADIO2_UART_TXD
+#define OT_RADIO2_UART_TXD (GPIO_NUM_17)
+#endif
+
+/**
+ * The default RXD pin of the second radio uart.
+ *
+ */
+#ifndef OT_RADIO2_UART_RXD
+#define OT_RADIO2_UART_RXD (GPIO_NUM_16)
+#endif
+
+/**
+ * The default RTS pin of the second radio uart, only used with hardware flow control.
+ *
+ */
+#ifndef OT_RADIO2_UART_RTS
+#define OT_RADIO2_UART_RTS (UART_PIN_NO_CHANGE)
+#endif
+
+/**
+ * The default CTS pin of the second radio uart, only used with hardware flow control.
+ *
+ */
+#ifndef OT_RADIO2_UART_CTS
+#define OT_RADIO2_UART_CTS (UART_PIN_NO_CHANGE)
+#endif
+
+/**
+ * The hardware flow control mode of the second radio uart.
+ *
+ */
+#ifndef OT_RADIO2_UART_FLOW_CTRL
+#define OT_RADIO2_UART_FLOW_CTRL (UART_HW_FLOWCTRL_DISABLE)
+#endif
+
+/**
+ * The baud rate of the second radio uart after reset.
+ *
+ */
+#ifndef OT_RADIO2_UART_BAUD_RATE
+#define OT_RADIO2_UART_BAUD_RATE OT_RADIO_UART_BAUD_RATE
+#endif
+
+/**
+ * The baud rate the radio uart is moved to when the radio is initialized.
+ *
+ * When not 0, the host asks the RCP to switch to this baud rate by setting the
+ * OT_RADIO_SPINEL_PROP_UART_BAUD_RATE property before the spinel radio starts.
+ * If the RCP does not support the property or does not answer, and does not
+ * answer a probe at this baud rate either, the radio uart stays at
+ * OT_RADIO_UART_BAUD_RATE.
+ *
+ */
+#ifndef OT_RADIO_UART_NEGOTIATED_BAUD_RATE
+#define OT_RADIO_UART_NEGOTIATED_BAUD_RATE 0
+#endif
+
+/**
+ * The vendor spinel property used to change the baud rate of the RCP uart.
+ *
+ * The value is a uint32 baud rate. The RCP MUST answer with the accepted value
+ * at the current baud rate before switching to the new one, and MUST keep the
+ * new baud rate across spinel resets until it is reset by hardware.
+ *
+ */
+#ifndef OT_RADIO_SPINEL_PROP_UART_BAUD_RATE
+#define OT_RADIO_SPINEL_PROP_UART_BAUD_RATE (SPINEL_PROP_VENDOR__BEGIN + 0x10)
+#endif
+
+/**
+ * This setting selects the SPI transport to the RCP instead of HDLC over the radio uart.
+ *
+ * The SPI transport uses the spinel SPI framing, the RCP is the SPI slave and
+ * signals pending frames with an active low interrupt line.
+ *
+ */
+#ifndef OT_RADIO_SPI_ENABLE
+#define OT_RADIO_SPI_ENABLE 0
+#endif
+
+/**
+ * This setting moves the radio uart reception and HDLC decoding to a dedicated task pinned to a core.
+ *
+ * Decoded spinel frames are handed to the mainloop through a lock-free queue, so on a dual-core chip decoding
+ * overlaps with the OpenThread processing on the other core, and is not delayed by long tasklets. The mainloop task
+ * should run on the other core than OT_RADIO_RX_TASK_CORE.
+ *
+ */
+#ifndef OT_RADIO_RX_TASK_ENABLE
+#define OT_RADIO_RX_TASK_ENABLE 0
+#endif
+
+/**
+ * The core the radio RX task is pinned to.
+ *
+ */
+#ifndef OT_RADIO_RX_TASK_CORE
+#define OT_RADIO_RX_TASK_CORE 0
+#endif
+
+/**
+ * The priority of the radio RX task, it should be higher than the priority of the mainloop task.
+ *
+ */
+#ifndef OT_RADIO_RX_TASK_PRIORITY
+#define OT_RADIO_RX_TASK_PRIORITY 6
+#endif
+
+/**
+ * The stack size of the radio RX task.
+ *
+ */
+#ifndef OT_RADIO_RX_TASK_STACK_SIZE
+#define OT_RADIO_RX_TASK_STACK_SIZE 3072
+#endif
+
+/**
+ * The size of the queue of decoded frames waiting for the mainloop, MUST be a power of two.
+ *
+ */
+#ifndef OT_RADIO_RX_QUEUE_SIZE
+#define OT_RADIO_RX_QUEUE_SIZE 4096
+#endif
+
+#if OT_RADIO_NUM < 1 || OT_RADIO_NUM > 2
+#error "OT_RADIO_NUM must be 1 or 2"
+#endif
+
+#if OT_RADIO_SPI_ENABLE && OT_RADIO_NUM > 1
+#error "multiple RCPs are only supported over uart"
+#endif
+
+#if OT_RADIO_SPI_ENABLE && OT_RADIO_RX_TASK_ENABLE
+#error "the radio RX task is only supported over uart"
+#endif
+
+/**
+ * The SPI host connected to the RCP.
+ *
+ */
+#ifndef OT_RADIO_SPI_HOST
+#define OT_RADIO_SPI_HOST (HSPI_HOST)
+#endif
+
+/**
+ * The default MOSI pin of the radio SPI.
+ *
+ */
+#ifndef OT_RADIO_SPI_MOSI
+#define OT_RADIO_SPI_MOSI (GPIO_NUM_13)
+#endif
+
+/**
+ * The default MISO pin of the radio SPI.
+ *
+ */
+#ifndef OT_RADIO_SPI_MISO
+#define OT_RADIO_SPI_MISO (GPIO_NUM_12)
+#endif
+
+/**
+ * The default SCLK pin of the radio SPI.
+ *
+ */
+#ifndef OT_RADIO_SPI_SCLK
+#define OT_RADIO_SPI_SCLK (GPIO_NUM_14)
+#endif
+
+/**
+ * The default CS pin of the radio SPI.
+ *
+ */
+#ifndef OT_RADIO_SPI_CS
+#define OT_RADIO_SPI_CS (GPIO_NUM_15)
+#endif
+
+/**
+ * The active low interrupt line the RCP asserts when it has a frame to send.
+ *
+ */
+#ifndef OT_RADIO_SPI_INT
+#define OT_RADIO_SPI_INT (GPIO_NUM_27)
+#endif
+
+/**
+ * The SPI clock frequency in Hz.
+ *
+ */
+#ifndef OT_RADIO_SPI_CLOCK_HZ
+#define OT_RADIO_SPI_CLOCK_HZ 4000000
+#endif
+
+/**
+ * The SPI mode (clock polarity and phase) used by the RCP.
+ *
+ */
+#ifndef OT_RADIO_SPI_MODE
+#define OT_RADIO_SPI_MODE 0
+#endif
+
+/**
+ * The number of payload bytes clocked when polling the RCP for a frame of unknown length.
+ *
+ * Frames up to this size are received in a single SPI transaction, larger ones take two.
+ *
+ */
+#ifndef OT_RADIO_SPI_SMALL_PACKET_SIZE
+#define OT_RADIO_SPI_SMALL_PACKET_SIZE 32
+#endif
+
+/**
+ * The maximum number of 0xff bytes the RCP may send before the spinel SPI header.
+ *
+ */
+#ifndef OT_RADIO_SPI_ALIGN_ALLOWANCE
+#define OT_RADIO_SPI_ALIGN_ALLOWANCE 0
+#endif
+
+/**
+ * The number of short address entries of the host side copy of the RCP source match table.
+ *
+ */
+#ifndef OT_RADIO_SRC_MATCH_SHORT_ENTRY_NUM
+#define OT_RADIO_SRC_MATCH_SHORT_ENTRY_NUM 32
+#endif
+
+/**
+ * The number of extended address entries of the host side copy of the RCP source match table.
+ *
+ */
+#ifndef OT_RADIO_SRC_MATCH_EXT_ENTRY_NUM
+#define OT_RADIO_SRC_MATCH_EXT_ENTRY_NUM 32
+#endif
+
 /**
  * The uart used by OpenThread CLI.
  *
@@ -95,10 +402,175 @@
 #define OT_CLI_UART_NUM (UART_NUM_0)
 
 /**
- * The uart receive buffer size for both CLI uart and radio uart.
+ * The baud rate of the CLI uart.
+ *
+ */
+#ifndef OT_CLI_UART_BAUD_RATE
+#define OT_CLI_UART_BAUD_RATE 115200
+#endif
+
+/**
+ * The longest time in milliseconds the mainloop may be kept from reading a uart without losing received bytes.
+ *
+ * The uart receive buffers are sized to hold the bytes received at full line rate during this interval.
+ *
+ */
+#ifndef OT_UART_RX_LATENCY_BUDGET
+#define OT_UART_RX_LATENCY_BUDGET 50
+#endif
+
+/**
+ * The uart receive buffer size holding OT_UART_RX_LATENCY_BUDGET worth of bytes at @p aBaudRate.
+ *
+ * The size is rounded up to a multiple of UART_FIFO_LEN, with at least two FIFOs of headroom.
+ *
+ */
+#define OT_UART_RX_BUF_SIZE_FOR(aBaudRate) \
+    ((((aBaudRate) / 10 * OT_UART_RX_LATENCY_BUDGET / 1000) / UART_FIFO_LEN + 2) * UART_FIFO_LEN)
+
+/**
+ * The receive buffer size of the CLI uart.
+ *
+ */
+#ifndef OT_CLI_UART_RX_BUF_SIZE
+#define OT_CLI_UART_RX_BUF_SIZE OT_UART_RX_BUF_SIZE_FOR(OT_CLI_UART_BAUD_RATE)
+#endif
+
+/**
+ * The receive buffer size of the radio uart, sized for the highest baud rate the link may run at.
+ *
+ */
+#ifndef OT_RADIO_UART_RX_BUF_SIZE
+#if OT_RADIO_UART_NEGOTIATED_BAUD_RATE > OT_RADIO_UART_BAUD_RATE
+#define OT_RADIO_UART_RX_BUF_SIZE OT_UART_RX_BUF_SIZE_FOR(OT_RADIO_UART_NEGOTIATED_BAUD_RATE)
+#else
+#define OT_RADIO_UART_RX_BUF_SIZE OT_UART_RX_BUF_SIZE_FOR(OT_RADIO_UART_BAUD_RATE)
+#endif
+#endif
+
+/**
+ * The length of the uart driver event queues.
+ *
+ */
+#ifndef OT_UART_EVENT_QUEUE_SIZE
+#define OT_UART_EVENT_QUEUE_SIZE 16
+#endif
+
+/**
+ * The stack size of the task forwarding uart driver events to the mainloop.
+ *
+ */
+#ifndef OT_UART_EVENT_TASK_STACK_SIZE
+#define OT_UART_EVENT_TASK_STACK_SIZE 2048
+#endif
+
+/**
+ * The priority of the task forwarding uart driver events to the mainloop.
+ *
+ */
+#ifndef OT_UART_EVENT_TASK_PRIORITY
+#define OT_UART_EVENT_TASK_PRIORITY 6
+#endif
+
+/**
+ * The maximum number of interrupt sources forwarded to the mainloop.
+ *
+ */
+#define OT_INTERRUPT_EVENT_MAX 2
+
+/**
+ * The maximum number of application handlers added to the mainloop.
+ *
+ */
+#ifndef OT_MAINLOOP_HANDLER_MAX
+#define OT_MAINLOOP_HANDLER_MAX 4
+#endif
+
+/**
+ * This setting enables the API lock statistics, see otSysGetApiLockStats().
  *
  */
-#define OT_UART_RX_BUF_SIZE (UART_FIFO_LEN * 2)
+#ifndef OT_API_LOCK_STATS_ENABLE
+#define OT_API_LOCK_STATS_ENABLE 0
+#endif
+
+/**
+ * The API lock hold time in microseconds above which a warning is logged, 0 to disable the warning.
+ *
+ * This setting is only used with OT_API_LOCK_STATS_ENABLE.
+ *
+ */
+#ifndef OT_API_LOCK_LONG_HOLD_THRESHOLD
+#define OT_API_LOCK_LONG_HOLD_THRESHOLD 50000
+#endif
+
+/**
+ * The maximum number of OpenThread API calls queued by otSysApiCallAsync().
+ *
+ */
+#ifndef OT_API_CALL_QUEUE_SIZE
+#define OT_API_CALL_QUEUE_SIZE 16
+#endif
+
+#if OT_MAINLOOP_HANDLER_MAX > 16
+#error "OT_MAINLOOP_HANDLER_MAX must not be larger than 16"
+#endif
+
+/**
+ * The highest CPU frequency in MHz used by power management.
+ *
+ */
+#ifndef OT_PM_MAX_FREQ_MHZ
+#define OT_PM_MAX_FREQ_MHZ CONFIG_ESP32_DEFAULT_CPU_FREQ_MHZ
+#endif
+
+/**
+ * The lowest CPU frequency in MHz used by power management when no task needs the CPU at full speed.
+ *
+ */
+#ifndef OT_PM_MIN_FREQ_MHZ
+#define OT_PM_MIN_FREQ_MHZ 40
+#endif
+
+/**
+ * The highest CLI UART baud rate with power management enabled.
+ *
+ * The CLI UART is then clocked by the 1 MHz REF_TICK, so that its baud rate does not change with the APB clock. The
+ * baud rate divider gets too coarse above this rate.
+ *
+ */
+#define OT_UART_REF_TICK_MAX_BAUD_RATE 250000
+
+#if CONFIG_PM_ENABLE
+#if OT_CLI_UART_BAUD_RATE > OT_UART_REF_TICK_MAX_BAUD_RATE
+#error "OT_CLI_UART_BAUD_RATE must not be larger than OT_UART_REF_TICK_MAX_BAUD_RATE with power management enabled"
+#endif
+#define OT_CLI_UART_USE_REF_TICK true
+#else
+#define OT_CLI_UART_USE_REF_TICK false
+#endif
+
+/**
+ * The number of rising edges on the RX line of a uart which wakes up the chip from light sleep.
+ *
+ * The bytes carrying these edges are not received.
+ *
+ */
+#ifndef OT_UART_WAKEUP_THRESHOLD
+#define OT_UART_WAKEUP_THRESHOLD 3
+#endif
+
+/**
+ * This setting makes the mainloop wait for a FreeRTOS event group instead of select() on the event file.
+ *
+ * All the platform drivers signal their events, so select() only ever waits for the event file. The event group
+ * wakes up the mainloop without going through the VFS. File descriptors added to the mainloop context by the
+ * application are not polled in this mode.
+ *
+ */
+#ifndef OT_MAINLOOP_EVENT_GROUP_ENABLE
+#define OT_MAINLOOP_EVENT_GROUP_ENABLE 0
+#endif
 
 /**
  * The minimum fd number reserved by the OpenThread platform driver.
@@ -139,6 +611,84 @@
  */
 #define OT_EVENT_VFS_PATH OT_EVENT_VFS_PREFIX OT_EVENT_VFS_SHORT_PATH
 
+/**
+ * The event signaled when the radio uart has received data.
+ *
+ */
+#define OT_EVENT_RADIO_UART (1UL << 0)
+
+/**
+ * The event signaled when the CLI uart has received data.
+ *
+ */
+#define OT_EVENT_CLI_UART (1UL << 1)
+
+/**
+ * The event signaled when the RCP asserts the SPI interrupt line.
+ *
+ */
+#define OT_EVENT_RADIO_SPI (1UL << 2)
+
+/**
+ * The event signaled when the second radio uart has received data.
+ *
+ */
+#define OT_EVENT_RADIO2_UART (1UL << 3)
+
+/**
+ * The event signaled when a microsecond alarm has expired.
+ *
+ */
+#define OT_EVENT_ALARM_MICRO (1UL << 4)
+
+/**
+ * The event signaled when a millisecond alarm has expired.
+ *
+ */
+#define OT_EVENT_ALARM_MILLI (1UL << 5)
+
+/**
+ * The event signaled by otSysMainloopBreak(), only used by the event group mainloop.
+ *
+ */
+#define OT_EVENT_MAINLOOP_BREAK (1UL << 6)
+
+/**
+ * The event signaled when an OpenThread API call has been queued.
+ *
+ */
+#define OT_EVENT_API_CALL (1UL << 7)
+
+/**
+ * The event signaled by otSysMainloopSignal() for the application handler in slot @p aIndex.
+ *
+ */
+#define OT_EVENT_MAINLOOP_HANDLER(aIndex) (1UL << (8 + (aIndex)))
+
+/**
+ * The events of all the application handler slots.
+ *
+ */
+#define OT_EVENT_MAINLOOP_HANDLER_ALL (((1UL << OT_MAINLOOP_HANDLER_MAX) - 1) << 8)
+
+/**
+ * The uart hardware FIFO overflowed, received bytes have been lost.
+ *
+ */
+#define OT_UART_ERROR_FIFO_OVF (1UL << 0)
+
+/**
+ * The uart driver receive buffer is full, reception stalls until it is read.
+ *
+ */
+#define OT_UART_ERROR_BUFFER_FULL (1UL << 1)
+
+/**
+ * A byte has been received with a framing or parity error.
+ *
+ */
+#define OT_UART_ERROR_FRAME (1UL << 2)
+
 /**
  * Milliseconds per Second.
  *
@@ -168,16 +718,42 @@ extern "C" {
 #endif
 
 /**
- * This function updates OpenThread alarm events to the mainloop context.
+ * This function initializes the alarms of all OpenThread instances.
  *
- * @param[inout]  aMainloop  The mainloop context;
+ */
+void platformAlarmInit(void);
+
+/**
+ * This function deinitializes the alarms of all OpenThread instances.
+ *
+ */
+void platformAlarmDeinit(void);
+
+/**
+ * This function gives an OpenThread instance the next free alarm.
+ *
+ * @param[in] aInstance  The OpenThread instance.
+ *
+ * @retval OT_ERROR_NONE     The instance has an alarm.
+ * @retval OT_ERROR_NO_BUFS  All alarms are in use.
+ *
+ */
+otError platformAlarmAddInstance(otInstance *aInstance);
+
+/**
+ * This function stops and frees the alarm of an OpenThread instance.
+ *
+ * @param[in] aInstance  The OpenThread instance.
  *
  */
-void platformAlarmUpdate(otSysMainloopContext *aMainloop);
+void platformAlarmRemoveInstance(otInstance *aInstance);
 
 /**
  * This function process alarm events.
  *
+ * The alarms of all OpenThread instances are processed. Alarms are armed as one-shot timers which wake up the mainloop
+ * when they expire, so nothing is done unless a timer has expired.
+ *
  * @param[in] aInstance  The OpenThread instance.
  * @param[in] aMainloop  The mainloop context.
  *
@@ -230,6 +806,25 @@ void platformRadioInit(bool aResetRadio, bool aRestoreDataSetFromNcp);
  */
 void platformRadioDeinit(void);
 
+/**
+ * This function gives an OpenThread instance the next free radio.
+ *
+ * @param[in] aInstance  The OpenThread instance.
+ *
+ * @retval OT_ERROR_NONE     The instance has a radio.
+ * @retval OT_ERROR_NO_BUFS  All radios are in use.
+ *
+ */
+otError platformRadioAddInstance(otInstance *aInstance);
+
+/**
+ * This function frees the radio of an OpenThread instance.
+ *
+ * @param[in] aInstance  The OpenThread instance.
+ *
+ */
+void platformRadioRemoveInstance(otInstance *aInstance);
+
 /**
  * This function updates spinel radio events to the mainloop context.
  *
@@ -241,12 +836,70 @@ void platformRadioUpdate(otSysMainloopContext *aMainloop);
 /**
  * This function process radio events.
  *
+ * The radios of all OpenThread instances are processed.
+ *
  * @param[in] aInstance  The OpenThread instance.
  * @param[in] aMainloop  The mainloop context.
  *
  */
 void platformRadioProcess(otInstance *aInstance, const otSysMainloopContext *aMainloop);
 
+/**
+ * This function indicates whether all radios are idle.
+ *
+ * A radio is idle when it is asleep or disabled and nothing is left to exchange with its RCP.
+ *
+ */
+bool platformRadioIsIdle(void);
+
+/**
+ * This function updates the file descriptor sets with the application handlers.
+ *
+ * @param[in] aMainloop  The mainloop context.
+ *
+ */
+void platformMainloopHandlerUpdate(otSysMainloopContext *aMainloop);
+
+/**
+ * This function processes the application handlers.
+ *
+ * @param[in] aMainloop  The mainloop context.
+ *
+ */
+void platformMainloopHandlerProcess(const otSysMainloopContext *aMainloop);
+
+/**
+ * This function initializes power management.
+ *
+ * When power management is enabled, the chip enters light sleep automatically while the mainloop waits for events in
+ * the OT_PLAT_MCU_POWER_STATE_LOW_POWER state, all radios are idle and all tasks are blocked. It is woken up by the
+ * uarts, the RCP and the alarm timers.
+ *
+ */
+void platformPowerInit(void);
+
+/**
+ * This function deinitializes power management.
+ *
+ */
+void platformPowerDeinit(void);
+
+/**
+ * This function marks the start of the mainloop waiting for events.
+ *
+ * Light sleep is allowed from here on if the MCU is in the low power state and all radios are idle.
+ *
+ */
+void platformPowerPollBegin(void);
+
+/**
+ * This function marks the end of the mainloop waiting for events.
+ *
+ * Light sleep is not allowed again until the next wait.
+ *
+ */
+void platformPowerPollEnd(void);
+
 /**
  * This function initializes the API lock.
  *
@@ -259,6 +912,42 @@ void platformApiLockInit(void);
  */
 void platformApiLockDeinit(void);
 
+/**
+ * This function indicates whether the calling task holds the API lock.
+ *
+ */
+bool platformApiLockIsHeld(void);
+
+/**
+ * This function is called by otSysApiLock() once the calling task holds the API lock.
+ *
+ * The wait of the mainloop task for the lock is recorded as a mainloop phase of its own.
+ *
+ */
+void platformMainloopApiLockTaken(void);
+
+/**
+ * This function initializes the OpenThread API call queue.
+ *
+ */
+void platformApiCallInit(void);
+
+/**
+ * This function deinitializes the OpenThread API call queue.
+ *
+ * The calls still queued are completed with OT_ERROR_ABORT without being run.
+ *
+ */
+void platformApiCallDeinit(void);
+
+/**
+ * This function runs the OpenThread API calls queued before the current mainloop iteration.
+ *
+ * @param[in] aInstance  The OpenThread instance.
+ *
+ */
+void platformApiCallProcess(otInstance *aInstance);
+
 /**
  * This function initializes VFS driver of event file.
  *
@@ -288,12 +977,148 @@ void platformVfsEventUpdate(otSysMainloopContext *aMainloop);
  */
 void platformVfsEventProcess(otInstance *aInstance, const otSysMainloopContext *aMainloop);
 
+/**
+ * This function waits for events, up to the timeout of the mainloop context.
+ *
+ * This function is only used by the event group mainloop.
+ *
+ * @param[in] aMainloop  The mainloop context.
+ *
+ * @returns 1 if events have been signaled, 0 on timeout.
+ *
+ */
+int platformVfsEventWait(const otSysMainloopContext *aMainloop);
+
 /**
  * This function activates the event file.
  *
  */
 void platformVfsEventActivate(void);
 
+/**
+ * This function signals events to the mainloop and activates the event file.
+ *
+ * This function is thread safe. The event file is only activated if one of @p aEvents
+ * was not already pending.
+ *
+ * @param[in] aEvents  A bit mask of OT_EVENT_* events.
+ *
+ */
+void platformVfsEventSignal(uint32_t aEvents);
+
+/**
+ * This function checks whether events were signaled before the current mainloop iteration.
+ *
+ * This function is only valid in the process stage, after the event file has been processed.
+ *
+ * @param[in] aEvents  A bit mask of OT_EVENT_* events.
+ *
+ * @returns TRUE if any of @p aEvents was signaled, FALSE otherwise.
+ *
+ */
+bool platformVfsEventIsSignaled(uint32_t aEvents);
+
+/**
+ * This function initializes the task forwarding uart driver events to the mainloop.
+ *
+ */
+void platformUartEventInit(void);
+
+/**
+ * This function deinitializes the task forwarding uart driver events and detaches all uart event queues.
+ *
+ */
+void platformUartEventDeinit(void);
+
+/**
+ * This function attaches the event queue of a uart driver.
+ *
+ * @param[in] aUart   The uart port.
+ * @param[in] aQueue  The event queue created by uart_driver_install().
+ * @param[in] aEvent  The OT_EVENT_* event signaled when the uart receives data or reports an error.
+ *
+ */
+void platformUartEventAdd(uart_port_t aUart, QueueHandle_t aQueue, uint32_t aEvent);
+
+/**
+ * This function detaches the event queue of a uart driver.
+ *
+ * This function MUST be called before the uart driver is deleted.
+ *
+ * @param[in] aUart  The uart port.
+ *
+ */
+void platformUartEventRemove(uart_port_t aUart);
+
+/**
+ * This function forwards the events of a uart to a task instead of the mainloop.
+ *
+ * The task is notified with xTaskNotifyGive() when the uart receives data or reports an error.
+ *
+ * @param[in] aUart  The uart port, its event queue MUST have been attached.
+ * @param[in] aTask  The task to notify, NULL to signal the mainloop again.
+ *
+ */
+void platformUartEventSetTask(uart_port_t aUart, TaskHandle_t aTask);
+
+/**
+ * This function returns and clears the errors reported by a uart driver since the last call.
+ *
+ * @param[in] aUart  The uart port.
+ *
+ * @returns A bit mask of OT_UART_ERROR_* errors.
+ *
+ */
+uint32_t platformUartEventTakeErrors(uart_port_t aUart);
+
+/**
+ * This function attaches a binary semaphore given from an interrupt handler.
+ *
+ * Interrupt handlers can not signal events directly, they give the semaphore and the
+ * uart event task signals @p aEvent on their behalf.
+ *
+ * @param[in] aSemaphore  The binary semaphore.
+ * @param[in] aEvent      The OT_EVENT_* event signaled when the semaphore is given.
+ *
+ */
+void platformInterruptEventAdd(SemaphoreHandle_t aSemaphore, uint32_t aEvent);
+
+/**
+ * This function detaches a binary semaphore attached by platformInterruptEventAdd().
+ *
+ * @param[in] aSemaphore  The binary semaphore.
+ *
+ */
+void platformInterruptEventRemove(SemaphoreHandle_t aSemaphore);
+
+/**
+ * This function records the number of bytes currently buffered by a uart driver.
+ *
+ * This function is called by the reader right before draining the uart, so that the
+ * high-water mark reflects how full the receive buffer gets.
+ *
+ * @param[in] aUart  The uart port.
+ *
+ */
+void platformUartEventSampleRxLevel(uart_port_t aUart);
+
+/**
+ * This function gets the error counters of a uart driver.
+ *
+ * @param[in]  aUart   The uart port.
+ * @param[out] aStats  A pointer to the statistics, the HDLC and buffer size fields are left untouched.
+ *
+ */
+void platformUartEventGetStats(uart_port_t aUart, otSysUartStats *aStats);
+
+/**
+ * This function resets the error counters of a uart driver.
+ *
+ * @param[in] aUart  The uart port.
+ *
+ */
+void platformUartEventResetStats(uart_port_t aUart);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,125 @@
+/*
+ *  Copyright (c) 2020, The OpenThread Authors.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  3. Neither the name of the copyright holder nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef OT_ESP32_PROPERTY_CACHE_HPP_
+#define OT_ESP32_PROPERTY_CACHE_HPP_
+
+#include <stdint.h>
+#include <string.h>
+
+namespace ot {
+
+namespace Esp32 {
+
+/**
+ * This class caches the value of a radio property last written to, or read from, the RCP.
+ *
+ * A cached value belongs to a generation, it is only valid as long as the RCP has not been reset, i.e. while the
+ * generation passed to the accessors stays the same.
+ *
+ */
+template <typename Type> class CachedProperty
+{
+public:
+    /**
+     * This constructor initializes the object without a valid value.
+     *
+     */
+    CachedProperty(void)
+        : mGeneration(0)
+        , mValid(false)
+    {
+    }
+
+    /**
+     * This method indicates whether the cached value is valid and equal to @p aValue.
+     *
+     * @param[in] aValue       The value to compare.
+     * @param[in] aGeneration  The current generation of the RCP.
+     *
+     */
+    bool Matches(const Type &aValue, uint32_t aGeneration) const
+    {
+        return IsValid(aGeneration) && memcmp(&mValue, &aValue, sizeof(Type)) == 0;
+    }
+
+    /**
+     * This method gets the cached value.
+     *
+     * @param[out] aValue       A reference to the value.
+     * @param[in]  aGeneration  The current generation of the RCP.
+     *
+     * @retval TRUE   The cached value is valid and has been copied to @p aValue.
+     * @retval FALSE  The cached value is not valid.
+     *
+     */
+    bool Get(Type &aValue, uint32_t aGeneration) const
+    {
+        bool valid = IsValid(aGeneration);
+
+        if (valid)
+        {
+            aValue = mValue;
+        }
+
+        return valid;
+    }
+
+    /**
+     * This method sets the cached value.
+     *
+     * @param[in] aValue       The value the RCP now holds.
+     * @param[in] aGeneration  The current generation of the RCP.
+     *
+     */
+    void Set(const Type &aValue, uint32_t aGeneration)
+    {
+        mValue      = aValue;
+        mGeneration = aGeneration;
+        mValid      = true;
+    }
+
+    /**
+     * This method invalidates the cached value.
+     *
+     */
+    void Invalidate(void) { mValid = false; }
+
+private:
+    bool IsValid(uint32_t aGeneration) const { return mValid && mGeneration == aGeneration; }
+
+    Type     mValue;
+    uint32_t mGeneration;
+    bool     mValid;
+};
+
+} // namespace Esp32
+
+} // namespace ot
+
+#endif // OT_ESP32_PROPERTY_CACHE_HPP_
@@ -36,26 +36,205 @@
 
 #include <openthread/platform/radio.h>
 
+#include <string.h>
+
+#include <esp_log.h>
+
+#include "property_cache.hpp"
 #include "radio_spinel.hpp"
+#include "src_match_table.hpp"
+
+#if OT_RADIO_SPI_ENABLE
+#include "spinel_spi.hpp"
+
+typedef ot::Esp32::SpiInterface RadioInterface;
+#else
 #include "spinel_hdlc.hpp"
 
-static ot::Spinel::RadioSpinel<ot::Esp32::HdlcInterface, otSysMainloopContext> sRadioSpinel;
+typedef ot::Esp32::HdlcInterface RadioInterface;
+#endif
+
+/**
+ * Address filter writes that have not been sent to the RCP yet.
+ *
+ * These writes do not fail in normal operation, so they are deferred and sent together before the next radio
+ * operation, or at the end of the mainloop pass, instead of blocking the caller for a spinel round-trip each.
+ *
+ */
+enum
+{
+    kPendingPanId           = 1 << 0,
+    kPendingShortAddress    = 1 << 1,
+    kPendingExtendedAddress = 1 << 2,
+    kPendingPromiscuous     = 1 << 3,
+};
+
+/**
+ * This structure holds the state of the radio driven by one OpenThread instance.
+ *
+ */
+struct Radio
+{
+    ot::Spinel::RadioSpinel<RadioInterface, otSysMainloopContext> mSpinel;
+    otInstance *                                                  mInstance;
+    uint32_t                                                      mInitCount;
+
+    // Host side copies of RCP properties, so that setting an unchanged value or reading a known value does not take
+    // a spinel round-trip.
+    ot::Esp32::CachedProperty<uint16_t>     mPanId;
+    ot::Esp32::CachedProperty<uint16_t>     mShortAddress;
+    ot::Esp32::CachedProperty<otExtAddress> mExtendedAddress;
+    ot::Esp32::CachedProperty<bool>         mPromiscuous;
+    ot::Esp32::CachedProperty<int8_t>       mTransmitPower;
+    ot::Esp32::CachedProperty<int8_t>       mCcaEnergyDetectThreshold;
+
+    uint8_t      mPendingProperties;
+    uint16_t     mPendingPanId;
+    uint16_t     mPendingShortAddress;
+    otExtAddress mPendingExtendedAddress;
+    bool         mPendingPromiscuous;
+
+    // Host side copy of the RCP source match table, changes are applied to the RCP in batches.
+    ot::Esp32::SrcMatchTable        mSrcMatchTable;
+    ot::Esp32::CachedProperty<bool> mRcpSrcMatchEnabled;
+    uint32_t                        mSrcMatchGeneration;
+    bool                            mSrcMatchEnabled;
+};
+
+static Radio sRadios[OT_RADIO_NUM];
+
+#if !OT_RADIO_SPI_ENABLE
+static const ot::Esp32::HdlcUartConfig sRadioUartConfigs[OT_RADIO_NUM] = {
+    {OT_RADIO_UART_NUM, OT_RADIO_UART_TXD, OT_RADIO_UART_RXD, OT_RADIO_UART_RTS, OT_RADIO_UART_CTS,
+     OT_RADIO_UART_FLOW_CTRL, OT_RADIO_UART_BAUD_RATE, OT_EVENT_RADIO_UART},
+#if OT_RADIO_NUM > 1
+    {OT_RADIO2_UART_NUM, OT_RADIO2_UART_TXD, OT_RADIO2_UART_RXD, OT_RADIO2_UART_RTS, OT_RADIO2_UART_CTS,
+     OT_RADIO2_UART_FLOW_CTRL, OT_RADIO2_UART_BAUD_RATE, OT_EVENT_RADIO2_UART},
+#endif
+};
+#endif
+
+/**
+ * This function returns the radio of an OpenThread instance, or NULL if the instance has none.
+ *
+ */
+static Radio *findRadio(otInstance *aInstance)
+{
+    Radio *radio = NULL;
+
+    VerifyOrExit(aInstance != NULL, OT_NOOP);
+
+    for (Radio &candidate : sRadios)
+    {
+        if (candidate.mInstance == aInstance)
+        {
+            ExitNow(radio = &candidate);
+        }
+    }
+
+exit:
+    return radio;
+}
+
+/**
+ * This function returns the radio of an OpenThread instance.
+ *
+ * OpenThread only calls the radio driver for instances created by `otSysInstanceInit()`, which have a radio.
+ *
+ */
+static Radio &getRadio(otInstance *aInstance)
+{
+    Radio *radio = findRadio(aInstance);
+
+    VerifyOrDie(radio != NULL, OT_EXIT_FAILURE);
+
+    return *radio;
+}
+
+/**
+ * This function returns the generation of the cached properties, which changes whenever the RCP is reset.
+ *
+ */
+static uint32_t getCacheGeneration(Radio &aRadio)
+{
+    return aRadio.mInitCount + aRadio.mSpinel.GetSpinelInterface().GetRcpResetCount();
+}
+
+/**
+ * This function writes the deferred address filter properties to the RCP.
+ *
+ * The properties are written one at a time, each waiting for the response of the RCP. A property which could not be
+ * written stays pending and is written again by the next flush.
+ *
+ * @param[in] aRadio  The radio to flush.
+ *
+ * @returns The error of the first property which could not be written, or OT_ERROR_NONE.
+ *
+ */
+static otError flushPendingProperties(Radio &aRadio)
+{
+    otError error = OT_ERROR_NONE;
+
+    VerifyOrExit(aRadio.mPendingProperties != 0, OT_NOOP);
+
+    if (aRadio.mPendingProperties & kPendingPanId)
+    {
+        SuccessOrExit(error = aRadio.mSpinel.SetPanId(aRadio.mPendingPanId));
+        aRadio.mPanId.Set(aRadio.mPendingPanId, getCacheGeneration(aRadio));
+        aRadio.mPendingProperties &= ~kPendingPanId;
+    }
+
+    if (aRadio.mPendingProperties & kPendingShortAddress)
+    {
+        SuccessOrExit(error = aRadio.mSpinel.SetShortAddress(aRadio.mPendingShortAddress));
+        aRadio.mShortAddress.Set(aRadio.mPendingShortAddress, getCacheGeneration(aRadio));
+        aRadio.mPendingProperties &= ~kPendingShortAddress;
+    }
+
+    if (aRadio.mPendingProperties & kPendingExtendedAddress)
+    {
+        SuccessOrExit(error = aRadio.mSpinel.SetExtendedAddress(aRadio.mPendingExtendedAddress));
+        aRadio.mExtendedAddress.Set(aRadio.mPendingExtendedAddress, getCacheGeneration(aRadio));
+        aRadio.mPendingProperties &= ~kPendingExtendedAddress;
+    }
+
+    if (aRadio.mPendingProperties & kPendingPromiscuous)
+    {
+        SuccessOrExit(error = aRadio.mSpinel.SetPromiscuous(aRadio.mPendingPromiscuous));
+        aRadio.mPromiscuous.Set(aRadio.mPendingPromiscuous, getCacheGeneration(aRadio));
+        aRadio.mPendingProperties &= ~kPendingPromiscuous;
+    }
+
+exit:
+    if (error != OT_ERROR_NONE)
+    {
+        ESP_LOGW(OT_PLAT_LOG_TAG, "failed to write radio properties: %s", otThreadErrorToString(error));
+    }
+
+    return error;
+}
 
 void otPlatRadioGetIeeeEui64(otInstance *aInstance, uint8_t *aIeeeEui64)
 {
-    OT_UNUSED_VARIABLE(aInstance);
-    SuccessOrDie(sRadioSpinel.GetIeeeEui64(aIeeeEui64));
+    Radio &radio = getRadio(aInstance);
+    SuccessOrDie(radio.mSpinel.GetIeeeEui64(aIeeeEui64));
 }
 
 void otPlatRadioSetPanId(otInstance *aInstance, uint16_t panid)
 {
-    OT_UNUSED_VARIABLE(aInstance);
-    SuccessOrDie(sRadioSpinel.SetPanId(panid));
+    Radio &radio = getRadio(aInstance);
+    radio.mPendingProperties &= ~kPendingPanId;
+    VerifyOrExit(!radio.mPanId.Matches(panid, getCacheGeneration(radio)), OT_NOOP);
+    radio.mPendingPanId = panid;
+    radio.mPendingProperties |= kPendingPanId;
+
+exit:
+    return;
 }
 
 void otPlatRadioSetExtendedAddress(otInstance *aInstance, const otExtAddress *aAddress)
 {
-    OT_UNUSED_VARIABLE(aInstance);
+    Radio &radio = getRadio(aInstance);
     otExtAddress addr;
 
     for (size_t i = 0; i < sizeof(addr); i++)
@@ -63,101 +242,230 @@ void otPlatRadioSetExtendedAddress(otInstance *aInstance, const otExtAddress *aA
         addr.m8[i] = aAddress->m8[sizeof(addr) - 1 - i];
     }
 
-    SuccessOrDie(sRadioSpinel.SetExtendedAddress(addr));
+    radio.mPendingProperties &= ~kPendingExtendedAddress;
+    VerifyOrExit(!radio.mExtendedAddress.Matches(addr, getCacheGeneration(radio)), OT_NOOP);
+    radio.mPendingExtendedAddress = addr;
+    radio.mPendingProperties |= kPendingExtendedAddress;
+
+exit:
+    return;
 }
 
 void otPlatRadioSetShortAddress(otInstance *aInstance, uint16_t aAddress)
 {
-    OT_UNUSED_VARIABLE(aInstance);
-    SuccessOrDie(sRadioSpinel.SetShortAddress(aAddress));
+    Radio &radio = getRadio(aInstance);
+    radio.mPendingProperties &= ~kPendingShortAddress;
+    VerifyOrExit(!radio.mShortAddress.Matches(aAddress, getCacheGeneration(radio)), OT_NOOP);
+    radio.mPendingShortAddress = aAddress;
+    radio.mPendingProperties |= kPendingShortAddress;
+
+exit:
+    return;
 }
 
 void otPlatRadioSetPromiscuous(otInstance *aInstance, bool aEnable)
 {
-    OT_UNUSED_VARIABLE(aInstance);
-    SuccessOrDie(sRadioSpinel.SetPromiscuous(aEnable));
+    Radio &radio = getRadio(aInstance);
+    radio.mPendingProperties &= ~kPendingPromiscuous;
+    VerifyOrExit(!radio.mPromiscuous.Matches(aEnable, getCacheGeneration(radio)), OT_NOOP);
+    radio.mPendingPromiscuous = aEnable;
+    radio.mPendingProperties |= kPendingPromiscuous;
+
+exit:
+    return;
 }
 
 bool otPlatRadioIsEnabled(otInstance *aInstance)
 {
-    OT_UNUSED_VARIABLE(aInstance);
-    return sRadioSpinel.IsEnabled();
+    Radio &radio = getRadio(aInstance);
+    return radio.mSpinel.IsEnabled();
 }
 
 otError otPlatRadioEnable(otInstance *aInstance)
 {
-    return sRadioSpinel.Enable(aInstance);
+    Radio & radio = getRadio(aInstance);
+    otError error;
+
+    SuccessOrExit(error = flushPendingProperties(radio));
+    error = radio.mSpinel.Enable(aInstance);
+
+exit:
+    return error;
 }
 
 otError otPlatRadioDisable(otInstance *aInstance)
 {
-    OT_UNUSED_VARIABLE(aInstance);
-    return sRadioSpinel.Disable();
+    Radio &radio = getRadio(aInstance);
+    return radio.mSpinel.Disable();
 }
 
 otError otPlatRadioSleep(otInstance *aInstance)
 {
-    OT_UNUSED_VARIABLE(aInstance);
-    return sRadioSpinel.Sleep();
+    Radio & radio = getRadio(aInstance);
+    otError error;
+
+    SuccessOrExit(error = flushPendingProperties(radio));
+    error = radio.mSpinel.Sleep();
+
+exit:
+    return error;
 }
 
 otError otPlatRadioReceive(otInstance *aInstance, uint8_t aChannel)
 {
-    OT_UNUSED_VARIABLE(aInstance);
-    return sRadioSpinel.Receive(aChannel);
+    Radio & radio = getRadio(aInstance);
+    otError error;
+
+    SuccessOrExit(error = flushPendingProperties(radio));
+    error = radio.mSpinel.Receive(aChannel);
+
+exit:
+    return error;
 }
 
 otError otPlatRadioTransmit(otInstance *aInstance, otRadioFrame *aFrame)
 {
-    OT_UNUSED_VARIABLE(aInstance);
-    return sRadioSpinel.Transmit(*aFrame);
+    Radio & radio = getRadio(aInstance);
+    otError error;
+
+    SuccessOrExit(error = flushPendingProperties(radio));
+    error = radio.mSpinel.Transmit(*aFrame);
+
+exit:
+    return error;
 }
 
 otRadioFrame *otPlatRadioGetTransmitBuffer(otInstance *aInstance)
 {
-    OT_UNUSED_VARIABLE(aInstance);
-    return &sRadioSpinel.GetTransmitFrame();
+    Radio &radio = getRadio(aInstance);
+    return &radio.mSpinel.GetTransmitFrame();
 }
 
 int8_t otPlatRadioGetRssi(otInstance *aInstance)
 {
-    OT_UNUSED_VARIABLE(aInstance);
-    return sRadioSpinel.GetRssi();
+    Radio &radio = getRadio(aInstance);
+    return radio.mSpinel.GetRssi();
 }
 
 otRadioCaps otPlatRadioGetCaps(otInstance *aInstance)
 {
-    OT_UNUSED_VARIABLE(aInstance);
-    return sRadioSpinel.GetRadioCaps();
+    Radio &radio = getRadio(aInstance);
+    return radio.mSpinel.GetRadioCaps();
 }
 
 const char *otPlatRadioGetVersionString(otInstance *aInstance)
 {
-    OT_UNUSED_VARIABLE(aInstance);
-    return sRadioSpinel.GetVersion();
+    Radio &radio = getRadio(aInstance);
+    return radio.mSpinel.GetVersion();
 }
 
 bool otPlatRadioGetPromiscuous(otInstance *aInstance)
 {
-    OT_UNUSED_VARIABLE(aInstance);
-    return sRadioSpinel.IsPromiscuous();
+    Radio &radio = getRadio(aInstance);
+    return (radio.mPendingProperties & kPendingPromiscuous) ? radio.mPendingPromiscuous : radio.mSpinel.IsPromiscuous();
+}
+
+/**
+ * This function applies source match table changes to the RCP.
+ *
+ * If the RCP can not hold all entries, source matching is disabled on the RCP, so that it sets the frame pending bit
+ * in all acks, until the entries it had no room for have been added.
+ *
+ */
+static void flushSrcMatchTable(Radio &aRadio)
+{
+    ot::Esp32::SrcMatchTable::Change change;
+    otError                          error = OT_ERROR_NONE;
+    bool                             enabled;
+
+    if (aRadio.mSrcMatchGeneration != getCacheGeneration(aRadio))
+    {
+        // The RCP has lost its table, write it again.
+        aRadio.mSrcMatchTable.Resync();
+        aRadio.mSrcMatchGeneration = getCacheGeneration(aRadio);
+    }
+
+    while (aRadio.mSrcMatchTable.GetNextChange(change))
+    {
+        switch (change.mOperation)
+        {
+        case ot::Esp32::SrcMatchTable::Change::kClearShortEntries:
+            error = aRadio.mSpinel.ClearSrcMatchShortEntries();
+            break;
+
+        case ot::Esp32::SrcMatchTable::Change::kClearExtEntries:
+            error = aRadio.mSpinel.ClearSrcMatchExtEntries();
+            break;
+
+        case ot::Esp32::SrcMatchTable::Change::kAddShortEntry:
+            error = aRadio.mSpinel.AddSrcMatchShortEntry(change.mShortAddress);
+            break;
+
+        case ot::Esp32::SrcMatchTable::Change::kAddExtEntry:
+            error = aRadio.mSpinel.AddSrcMatchExtEntry(change.mExtAddress);
+            break;
+
+        case ot::Esp32::SrcMatchTable::Change::kClearShortEntry:
+            error = aRadio.mSpinel.ClearSrcMatchShortEntry(change.mShortAddress);
+            break;
+
+        case ot::Esp32::SrcMatchTable::Change::kClearExtEntry:
+            error = aRadio.mSpinel.ClearSrcMatchExtEntry(change.mExtAddress);
+            break;
+        }
+
+        if (error == OT_ERROR_NONE)
+        {
+            aRadio.mSrcMatchTable.CommitChange(change);
+        }
+        else if (change.mOperation == ot::Esp32::SrcMatchTable::Change::kAddShortEntry ||
+                 change.mOperation == ot::Esp32::SrcMatchTable::Change::kAddExtEntry)
+        {
+            // The RCP table is full, the entry is added again once an entry has been cleared.
+            aRadio.mSrcMatchTable.RejectChange(change);
+        }
+        else if (error == OT_ERROR_NO_ADDRESS)
+        {
+            // The RCP did not hold the entry, which is what clearing it was meant to achieve.
+            aRadio.mSrcMatchTable.CommitChange(change);
+        }
+        else
+        {
+            // The RCP table is unknown, the change stays pending and is retried by the next flush.
+            ESP_LOGW(OT_PLAT_LOG_TAG, "rcp source match clear failed: %s", otThreadErrorToString(error));
+            break;
+        }
+    }
+
+    enabled = aRadio.mSrcMatchEnabled && !aRadio.mSrcMatchTable.IsOverflowed();
+
+    if (!aRadio.mRcpSrcMatchEnabled.Matches(enabled, getCacheGeneration(aRadio)))
+    {
+        if (aRadio.mSrcMatchEnabled && !enabled)
+        {
+            ESP_LOGW(OT_PLAT_LOG_TAG, "rcp source match table full, frame pending set in all acks");
+        }
+
+        SuccessOrDie(aRadio.mSpinel.EnableSrcMatch(enabled));
+        aRadio.mRcpSrcMatchEnabled.Set(enabled, getCacheGeneration(aRadio));
+    }
 }
 
 void otPlatRadioEnableSrcMatch(otInstance *aInstance, bool aEnable)
 {
-    OT_UNUSED_VARIABLE(aInstance);
-    SuccessOrDie(sRadioSpinel.EnableSrcMatch(aEnable));
+    Radio &radio = getRadio(aInstance);
+    radio.mSrcMatchEnabled = aEnable;
 }
 
 otError otPlatRadioAddSrcMatchShortEntry(otInstance *aInstance, uint16_t aShortAddress)
 {
-    OT_UNUSED_VARIABLE(aInstance);
-    return sRadioSpinel.AddSrcMatchShortEntry(aShortAddress);
+    Radio &radio = getRadio(aInstance);
+    return radio.mSrcMatchTable.AddShortEntry(aShortAddress);
 }
 
 otError otPlatRadioAddSrcMatchExtEntry(otInstance *aInstance, const otExtAddress *aExtAddress)
 {
-    OT_UNUSED_VARIABLE(aInstance);
+    Radio &radio = getRadio(aInstance);
     otExtAddress addr;
 
     for (size_t i = 0; i < sizeof(addr); i++)
@@ -165,18 +473,18 @@ otError otPlatRadioAddSrcMatchExtEntry(otInstance *aInstance, const otExtAddress
         addr.m8[i] = aExtAddress->m8[sizeof(addr) - 1 - i];
     }
 
-    return sRadioSpinel.AddSrcMatchExtEntry(addr);
+    return radio.mSrcMatchTable.AddExtEntry(addr);
 }
 
 otError otPlatRadioClearSrcMatchShortEntry(otInstance *aInstance, uint16_t aShortAddress)
 {
-    OT_UNUSED_VARIABLE(aInstance);
-    return sRadioSpinel.ClearSrcMatchShortEntry(aShortAddress);
+    Radio &radio = getRadio(aInstance);
+    return radio.mSrcMatchTable.ClearShortEntry(aShortAddress);
 }
 
 otError otPlatRadioClearSrcMatchExtEntry(otInstance *aInstance, const otExtAddress *aExtAddress)
 {
-    OT_UNUSED_VARIABLE(aInstance);
+    Radio &radio = getRadio(aInstance);
     otExtAddress addr;
 
     for (size_t i = 0; i < sizeof(addr); i++)
@@ -184,34 +492,42 @@ otError otPlatRadioClearSrcMatchExtEntry(otInstance *aInstance, const otExtAddre
         addr.m8[i] = aExtAddress->m8[sizeof(addr) - 1 - i];
     }
 
-    return sRadioSpinel.ClearSrcMatchExtEntry(addr);
+    return radio.mSrcMatchTable.ClearExtEntry(addr);
 }
 
 void otPlatRadioClearSrcMatchShortEntries(otInstance *aInstance)
 {
-    OT_UNUSED_VARIABLE(aInstance);
-    SuccessOrDie(sRadioSpinel.ClearSrcMatchShortEntries());
+    Radio &radio = getRadio(aInstance);
+    radio.mSrcMatchTable.ClearShortEntries();
 }
 
 void otPlatRadioClearSrcMatchExtEntries(otInstance *aInstance)
 {
-    OT_UNUSED_VARIABLE(aInstance);
-    SuccessOrDie(sRadioSpinel.ClearSrcMatchExtEntries());
+    Radio &radio = getRadio(aInstance);
+    radio.mSrcMatchTable.ClearExtEntries();
 }
 
 otError otPlatRadioEnergyScan(otInstance *aInstance, uint8_t aScanChannel, uint16_t aScanDuration)
 {
-    OT_UNUSED_VARIABLE(aInstance);
-    return sRadioSpinel.EnergyScan(aScanChannel, aScanDuration);
+    Radio & radio = getRadio(aInstance);
+    otError error;
+
+    SuccessOrExit(error = flushPendingProperties(radio));
+    error = radio.mSpinel.EnergyScan(aScanChannel, aScanDuration);
+
+exit:
+    return error;
 }
 
 otError otPlatRadioGetTransmitPower(otInstance *aInstance, int8_t *aPower)
 {
     otError error;
 
-    OT_UNUSED_VARIABLE(aInstance);
+    Radio &radio = getRadio(aInstance);
     VerifyOrExit(aPower != NULL, error = OT_ERROR_INVALID_ARGS);
-    error = sRadioSpinel.GetTransmitPower(*aPower);
+    VerifyOrExit(!radio.mTransmitPower.Get(*aPower, getCacheGeneration(radio)), error = OT_ERROR_NONE);
+    SuccessOrExit(error = radio.mSpinel.GetTransmitPower(*aPower));
+    radio.mTransmitPower.Set(*aPower, getCacheGeneration(radio));
 
 exit:
     return error;
@@ -219,17 +535,29 @@ exit:
 
 otError otPlatRadioSetTransmitPower(otInstance *aInstance, int8_t aPower)
 {
-    OT_UNUSED_VARIABLE(aInstance);
-    return sRadioSpinel.SetTransmitPower(aPower);
+    otError error = OT_ERROR_NONE;
+
+    Radio &radio = getRadio(aInstance);
+    VerifyOrExit(!radio.mTransmitPower.Matches(aPower, getCacheGeneration(radio)), OT_NOOP);
+
+    // The value held by the RCP is unknown if the set fails.
+    radio.mTransmitPower.Invalidate();
+    SuccessOrExit(error = radio.mSpinel.SetTransmitPower(aPower));
+    radio.mTransmitPower.Set(aPower, getCacheGeneration(radio));
+
+exit:
+    return error;
 }
 
 otError otPlatRadioGetCcaEnergyDetectThreshold(otInstance *aInstance, int8_t *aThreshold)
 {
     otError error;
 
-    OT_UNUSED_VARIABLE(aInstance);
+    Radio &radio = getRadio(aInstance);
     VerifyOrExit(aThreshold != NULL, error = OT_ERROR_INVALID_ARGS);
-    error = sRadioSpinel.GetCcaEnergyDetectThreshold(*aThreshold);
+    VerifyOrExit(!radio.mCcaEnergyDetectThreshold.Get(*aThreshold, getCacheGeneration(radio)), error = OT_ERROR_NONE);
+    SuccessOrExit(error = radio.mSpinel.GetCcaEnergyDetectThreshold(*aThreshold));
+    radio.mCcaEnergyDetectThreshold.Set(*aThreshold, getCacheGeneration(radio));
 
 exit:
     return error;
@@ -237,38 +565,48 @@ exit:
 
 otError otPlatRadioSetCcaEnergyDetectThreshold(otInstance *aInstance, int8_t aThreshold)
 {
-    OT_UNUSED_VARIABLE(aInstance);
-    return sRadioSpinel.SetCcaEnergyDetectThreshold(aThreshold);
+    otError error = OT_ERROR_NONE;
+
+    Radio &radio = getRadio(aInstance);
+    VerifyOrExit(!radio.mCcaEnergyDetectThreshold.Matches(aThreshold, getCacheGeneration(radio)), OT_NOOP);
+
+    // The value held by the RCP is unknown if the set fails.
+    radio.mCcaEnergyDetectThreshold.Invalidate();
+    SuccessOrExit(error = radio.mSpinel.SetCcaEnergyDetectThreshold(aThreshold));
+    radio.mCcaEnergyDetectThreshold.Set(aThreshold, getCacheGeneration(radio));
+
+exit:
+    return error;
 }
 
 int8_t otPlatRadioGetReceiveSensitivity(otInstance *aInstance)
 {
-    OT_UNUSED_VARIABLE(aInstance);
-    return sRadioSpinel.GetReceiveSensitivity();
+    Radio &radio = getRadio(aInstance);
+    return radio.mSpinel.GetReceiveSensitivity();
 }
 
 #if OPENTHREAD_CONFIG_PLATFORM_RADIO_COEX_ENABLE
 otError otPlatRadioSetCoexEnabled(otInstance *aInstance, bool aEnabled)
 {
-    OT_UNUSED_VARIABLE(aInstance);
-    return sRadioSpinel.SetCoexEnabled(aEnabled);
+    Radio &radio = getRadio(aInstance);
+    return radio.mSpinel.SetCoexEnabled(aEnabled);
 }
 
 bool otPlatRadioIsCoexEnabled(otInstance *aInstance)
 {
-    OT_UNUSED_VARIABLE(aInstance);
-    return sRadioSpinel.IsCoexEnabled();
+    Radio &radio = getRadio(aInstance);
+    return radio.mSpinel.IsCoexEnabled();
 }
 
 otError otPlatRadioGetCoexMetrics(otInstance *aInstance, otRadioCoexMetrics *aCoexMetrics)
 {
-    OT_UNUSED_VARIABLE(aInstance);
+    Radio &radio = getRadio(aInstance);
 
     otError error = OT_ERROR_NONE;
 
     VerifyOrExit(aCoexMetrics != NULL, error = OT_ERROR_INVALID_ARGS);
 
-    error = sRadioSpinel.GetCoexMetrics(*aCoexMetrics);
+    error = radio.mSpinel.GetCoexMetrics(*aCoexMetrics);
 
 exit:
     return error;
@@ -279,7 +617,7 @@ exit:
 otError otPlatDiagProcess(otInstance *aInstance, int argc, char *argv[], char *aOutput, size_t aOutputMaxLen)
 {
     // deliver the platform specific diags commands to radio only ncp.
-    OT_UNUSED_VARIABLE(aInstance);
+    Radio &radio = getRadio(aInstance);
     char  cmd[OPENTHREAD_CONFIG_DIAG_CMD_LINE_BUFFER_SIZE] = {'\0'};
     char *cur                                              = cmd;
     char *end                                              = cmd + sizeof(cmd);
@@ -289,13 +627,19 @@ otError otPlatDiagProcess(otInstance *aInstance, int argc, char *argv[], char *a
         cur += snprintf(cur, static_cast<size_t>(end - cur), "%s ", argv[index]);
     }
 
-    return sRadioSpinel.PlatDiagProcess(cmd, aOutput, aOutputMaxLen);
+    // Platform specific commands may change the transmit power behind the cache.
+    radio.mTransmitPower.Invalidate();
+
+    return radio.mSpinel.PlatDiagProcess(cmd, aOutput, aOutputMaxLen);
 }
 
 void otPlatDiagModeSet(bool aMode)
 {
-    SuccessOrExit(sRadioSpinel.PlatDiagProcess(aMode ? "start" : "stop", NULL, 0));
-    sRadioSpinel.SetDiagEnabled(aMode);
+    // Diagnostics without an instance are run on the first radio.
+    Radio &radio = sRadios[0];
+
+    SuccessOrExit(radio.mSpinel.PlatDiagProcess(aMode ? "start" : "stop", NULL, 0));
+    radio.mSpinel.SetDiagEnabled(aMode);
 
 exit:
     return;
@@ -303,7 +647,7 @@ exit:
 
 bool otPlatDiagModeGet(void)
 {
-    return sRadioSpinel.IsDiagEnabled();
+    return sRadios[0].mSpinel.IsDiagEnabled();
 }
 
 void otPlatDiagTxPowerSet(int8_t aTxPower)
@@ -311,7 +655,10 @@ void otPlatDiagTxPowerSet(int8_t aTxPower)
     char cmd[OPENTHREAD_CONFIG_DIAG_CMD_LINE_BUFFER_SIZE];
 
     snprintf(cmd, sizeof(cmd), "power %d", aTxPower);
-    SuccessOrExit(sRadioSpinel.PlatDiagProcess(cmd, NULL, 0));
+
+    // The RCP transmit power no longer matches the cached one, whether or not the command succeeds.
+    sRadios[0].mTransmitPower.Invalidate();
+    SuccessOrExit(sRadios[0].mSpinel.PlatDiagProcess(cmd, NULL, 0));
 
 exit:
     return;
@@ -322,7 +669,7 @@ void otPlatDiagChannelSet(uint8_t aChannel)
     char cmd[OPENTHREAD_CONFIG_DIAG_CMD_LINE_BUFFER_SIZE];
 
     snprintf(cmd, sizeof(cmd), "channel %d", aChannel);
-    SuccessOrExit(sRadioSpinel.PlatDiagProcess(cmd, NULL, 0));
+    SuccessOrExit(sRadios[0].mSpinel.PlatDiagProcess(cmd, NULL, 0));
 
 exit:
     return;
@@ -343,40 +690,213 @@ void otPlatDiagAlarmCallback(otInstance *aInstance)
 
 uint32_t otPlatRadioGetSupportedChannelMask(otInstance *aInstance)
 {
-    OT_UNUSED_VARIABLE(aInstance);
-    return sRadioSpinel.GetRadioChannelMask(false);
+    Radio &radio = getRadio(aInstance);
+    return radio.mSpinel.GetRadioChannelMask(false);
 }
 
 uint32_t otPlatRadioGetPreferredChannelMask(otInstance *aInstance)
 {
-    OT_UNUSED_VARIABLE(aInstance);
-    return sRadioSpinel.GetRadioChannelMask(true);
+    Radio &radio = getRadio(aInstance);
+    return radio.mSpinel.GetRadioChannelMask(true);
 }
 
 otRadioState otPlatRadioGetState(otInstance *aInstance)
 {
-    OT_UNUSED_VARIABLE(aInstance);
-    return sRadioSpinel.GetState();
+    Radio &radio = getRadio(aInstance);
+    return radio.mSpinel.GetState();
 }
 
 void platformRadioInit(bool aResetRadio, bool aRestoreDataSetFromNcp)
 {
-    sRadioSpinel.GetSpinelInterface().Init();
-    sRadioSpinel.Init(aResetRadio, aRestoreDataSetFromNcp);
+    for (int i = 0; i < OT_RADIO_NUM; i++)
+    {
+        Radio &radio = sRadios[i];
+
+        // Whatever has been cached belongs to the previous RCP session.
+        radio.mInitCount++;
+
+#if OT_RADIO_SPI_ENABLE
+        radio.mSpinel.GetSpinelInterface().Init();
+#else
+        radio.mSpinel.GetSpinelInterface().Init(sRadioUartConfigs[i]);
+#endif
+
+#if OT_RADIO_UART_NEGOTIATED_BAUD_RATE && !OT_RADIO_SPI_ENABLE
+        // Negotiated before RadioSpinel starts, so no transaction of its own can be outstanding. Failing to negotiate
+        // is not fatal, the link keeps running at the default baud rate.
+        radio.mSpinel.GetSpinelInterface().NegotiateBaudRate(OT_RADIO_UART_NEGOTIATED_BAUD_RATE);
+#endif
+
+        radio.mSpinel.Init(aResetRadio, aRestoreDataSetFromNcp);
+    }
+}
+
+otError platformRadioAddInstance(otInstance *aInstance)
+{
+    otError error = OT_ERROR_NO_BUFS;
+
+    VerifyOrExit(findRadio(aInstance) == NULL, error = OT_ERROR_NONE);
+
+    for (Radio &radio : sRadios)
+    {
+        if (radio.mInstance == NULL)
+        {
+            radio.mInstance = aInstance;
+            ExitNow(error = OT_ERROR_NONE);
+        }
+    }
+
+exit:
+    return error;
+}
+
+void platformRadioRemoveInstance(otInstance *aInstance)
+{
+    Radio *radio = findRadio(aInstance);
+
+    if (radio != NULL)
+    {
+        radio->mInstance = NULL;
+    }
 }
 
 void platformRadioDeinit(void)
 {
-    sRadioSpinel.Deinit();
+    for (Radio &radio : sRadios)
+    {
+        radio.mSpinel.Deinit();
+
+        // The instance is finalized together with the radio, its radio is free for the next one.
+        radio.mInstance = NULL;
+    }
 }
 
 void platformRadioProcess(otInstance *aInstance, const otSysMainloopContext *aMainloop)
 {
-    (void)aInstance;
-    sRadioSpinel.Process(*aMainloop);
+    OT_UNUSED_VARIABLE(aInstance);
+
+    for (Radio &radio : sRadios)
+    {
+        radio.mSpinel.Process(*aMainloop);
+    }
 }
 
 void platformRadioUpdate(otSysMainloopContext *aMainloop)
 {
-    sRadioSpinel.GetSpinelInterface().Update(*aMainloop);
+    for (Radio &radio : sRadios)
+    {
+        // Property and source match changes made by the tasklets just processed are applied in one batch. A failed
+        // property is retried by the next radio operation.
+        flushPendingProperties(radio);
+        flushSrcMatchTable(radio);
+
+        radio.mSpinel.GetSpinelInterface().Update(*aMainloop);
+    }
+}
+
+bool platformRadioIsIdle(void)
+{
+    bool idle = true;
+
+    for (Radio &radio : sRadios)
+    {
+        otRadioState state = radio.mSpinel.GetState();
+
+        if ((state != OT_RADIO_STATE_SLEEP && state != OT_RADIO_STATE_DISABLED) ||
+            !radio.mSpinel.GetSpinelInterface().IsIdle())
+        {
+            ExitNow(idle = false);
+        }
+    }
+
+exit:
+    return idle;
+}
+
+void otSysGetRadioUartStats(otInstance *aInstance, otSysUartStats *aStats)
+{
+    Radio *radio = findRadio(aInstance);
+
+    memset(aStats, 0, sizeof(*aStats));
+    VerifyOrExit(radio != NULL, OT_NOOP);
+
+#if !OT_RADIO_SPI_ENABLE
+    platformUartEventGetStats(sRadioUartConfigs[radio - sRadios].mPort, aStats);
+    aStats->mHdlcResyncs  = radio->mSpinel.GetSpinelInterface().GetHdlcResyncs();
+    aStats->mRxBufferSize = OT_RADIO_UART_RX_BUF_SIZE;
+#endif
+
+exit:
+    return;
+}
+
+void otSysGetRcpLinkStats(otInstance *aInstance, otSysRcpLinkStats *aStats)
+{
+    Radio *radio = findRadio(aInstance);
+
+    memset(aStats, 0, sizeof(*aStats));
+    VerifyOrExit(radio != NULL, OT_NOOP);
+
+    *aStats = radio->mSpinel.GetSpinelInterface().GetLinkStats();
+
+exit:
+    return;
+}
+
+void otSysResetRcpLinkStats(otInstance *aInstance)
+{
+    Radio *radio = findRadio(aInstance);
+
+    VerifyOrExit(radio != NULL, OT_NOOP);
+    radio->mSpinel.GetSpinelInterface().ResetLinkStats();
+
+exit:
+    return;
+}
+
+otError otSysConvertRcpTimeToHostTime(otInstance *aInstance, uint64_t aRcpTime, uint64_t *aHostTime)
+{
+    otError error = OT_ERROR_NONE;
+    Radio * radio = findRadio(aInstance);
+
+    VerifyOrExit(radio != NULL, error = OT_ERROR_INVALID_ARGS);
+    error = radio->mSpinel.GetSpinelInterface().GetRcpClock().ToHostTime(aRcpTime, *aHostTime);
+
+exit:
+    return error;
+}
+
+otError otSysConvertHostTimeToRcpTime(otInstance *aInstance, uint64_t aHostTime, uint64_t *aRcpTime)
+{
+    otError error = OT_ERROR_NONE;
+    Radio * radio = findRadio(aInstance);
+
+    VerifyOrExit(radio != NULL, error = OT_ERROR_INVALID_ARGS);
+    error = radio->mSpinel.GetSpinelInterface().GetRcpClock().ToRcpTime(aHostTime, *aRcpTime);
+
+exit:
+    return error;
+}
+
+int32_t otSysGetRcpClockDrift(otInstance *aInstance)
+{
+    Radio *radio = findRadio(aInstance);
+
+    return (radio != NULL) ? radio->mSpinel.GetSpinelInterface().GetRcpClock().GetDrift() : 0;
+}
+
+void otSysResetUartStats(otInstance *aInstance)
+{
+    Radio *radio = findRadio(aInstance);
+
+    platformUartEventResetStats(OT_CLI_UART_NUM);
+    VerifyOrExit(radio != NULL, OT_NOOP);
+
+#if !OT_RADIO_SPI_ENABLE
+    platformUartEventResetStats(sRadioUartConfigs[radio - sRadios].mPort);
+    radio->mSpinel.GetSpinelInterface().ResetHdlcResyncs();
+#endif
+
+exit:
+    return;
 }
@@ -0,0 +1,181 @@
+/*
+ *  Copyright (c) 2020, The OpenThread Authors.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  3. Neither the name of the copyright holder nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file implements tracking the clock of the Radio Co-processor (RCP).
+ */
+
+#include "rcp_clock.hpp"
+
+#include "error_handling.h"
+#include "lib/spinel/spinel.h"
+
+namespace ot {
+
+namespace Esp32 {
+
+RcpClock::RcpClock(void)
+{
+    Reset();
+}
+
+void RcpClock::Reset(void)
+{
+    mValid            = false;
+    mRefTime          = 0;
+    mRefOffset        = 0;
+    mDrift            = 0;
+    mHasLastWindow    = false;
+    mLastWindowTime   = 0;
+    mLastWindowOffset = 0;
+    mWindowStart      = 0;
+    mWindowMinTime    = 0;
+    mWindowMinOffset  = 0;
+}
+
+void RcpClock::HandleReceivedFrame(const uint8_t *aFrame, uint16_t aLength, uint64_t aHostTime)
+{
+    uint8_t           header;
+    unsigned int      command;
+    spinel_prop_key_t key;
+    const uint8_t *   psdu;
+    spinel_size_t     psduLength;
+    int8_t            rssi;
+    int8_t            noiseFloor;
+    uint16_t          flags;
+    uint8_t           channel;
+    uint8_t           lqi;
+    uint64_t          timestamp;
+    spinel_ssize_t    unpacked;
+
+    unpacked = spinel_datatype_unpack(aFrame, aLength, SPINEL_DATATYPE_COMMAND_PROP_S, &header, &command, &key);
+    VerifyOrExit(unpacked > 0 && command == SPINEL_CMD_PROP_VALUE_IS && key == SPINEL_PROP_STREAM_RAW, OT_NOOP);
+
+    unpacked = spinel_datatype_unpack(
+        aFrame + unpacked, static_cast<spinel_size_t>(aLength - unpacked),
+        SPINEL_DATATYPE_DATA_WLEN_S SPINEL_DATATYPE_INT8_S SPINEL_DATATYPE_INT8_S SPINEL_DATATYPE_UINT16_S
+            SPINEL_DATATYPE_STRUCT_S(SPINEL_DATATYPE_UINT8_S SPINEL_DATATYPE_UINT8_S SPINEL_DATATYPE_UINT64_S),
+        &psdu, &psduLength, &rssi, &noiseFloor, &flags, &channel, &lqi, &timestamp);
+
+    // RCPs not stamping received frames report a zero timestamp.
+    VerifyOrExit(unpacked > 0 && timestamp != 0, OT_NOOP);
+
+    // The RCP sends the frame once it has been received entirely, the timestamp is taken at its start.
+    AddSample(aHostTime, static_cast<int64_t>(aHostTime - psduLength * kOctetDuration - timestamp));
+
+exit:
+    return;
+}
+
+int64_t RcpClock::GetOffset(uint64_t aHostTime) const
+{
+    int64_t elapsed = static_cast<int64_t>(aHostTime - mRefTime);
+
+    return mRefOffset + static_cast<int64_t>(mDrift) * elapsed / 1000000000;
+}
+
+void RcpClock::AddSample(uint64_t aHostTime, int64_t aOffset)
+{
+    if (!mValid)
+    {
+        mValid           = true;
+        mRefTime         = aHostTime;
+        mRefOffset       = aOffset;
+        mWindowStart     = aHostTime;
+        mWindowMinTime   = aHostTime;
+        mWindowMinOffset = aOffset;
+        ExitNow();
+    }
+
+    if (aHostTime - mWindowStart >= kWindowDuration)
+    {
+        if (mHasLastWindow && mWindowMinTime > mLastWindowTime)
+        {
+            int64_t drift = (mWindowMinOffset - mLastWindowOffset) * 1000000000 /
+                            static_cast<int64_t>(mWindowMinTime - mLastWindowTime);
+
+            // A window without a quickly delivered frame gives an outlier, it is not taken into account.
+            if (drift >= -kMaxDrift && drift <= kMaxDrift)
+            {
+                mDrift += (static_cast<int32_t>(drift) - mDrift) / (1 << kDriftSmoothing);
+            }
+        }
+
+        mHasLastWindow    = true;
+        mLastWindowTime   = mWindowMinTime;
+        mLastWindowOffset = mWindowMinOffset;
+        mRefTime          = mWindowMinTime;
+        mRefOffset        = mWindowMinOffset;
+
+        mWindowStart     = aHostTime;
+        mWindowMinTime   = aHostTime;
+        mWindowMinOffset = aOffset;
+    }
+    else if (aOffset - GetOffset(aHostTime) < mWindowMinOffset - GetOffset(mWindowMinTime))
+    {
+        mWindowMinTime   = aHostTime;
+        mWindowMinOffset = aOffset;
+    }
+
+    // Delivery delays only add to the offset, a sample below the estimate is the most accurate one so far.
+    if (aOffset < GetOffset(aHostTime))
+    {
+        mRefTime   = aHostTime;
+        mRefOffset = aOffset;
+    }
+
+exit:
+    return;
+}
+
+otError RcpClock::ToHostTime(uint64_t aRcpTime, uint64_t &aHostTime) const
+{
+    otError error = OT_ERROR_NONE;
+
+    VerifyOrExit(mValid, error = OT_ERROR_INVALID_STATE);
+    aHostTime = aRcpTime + static_cast<uint64_t>(GetOffset(aRcpTime + static_cast<uint64_t>(mRefOffset)));
+
+exit:
+    return error;
+}
+
+otError RcpClock::ToRcpTime(uint64_t aHostTime, uint64_t &aRcpTime) const
+{
+    otError error = OT_ERROR_NONE;
+
+    VerifyOrExit(mValid, error = OT_ERROR_INVALID_STATE);
+    aRcpTime = aHostTime - static_cast<uint64_t>(GetOffset(aHostTime));
+
+exit:
+    return error;
+}
+
+} // namespace Esp32
+
+} // namespace ot
@@ -0,0 +1,140 @@
+/*
+ *  Copyright (c) 2020, The OpenThread Authors.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  3. Neither the name of the copyright holder nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file includes definitions for tracking the clock of the Radio Co-processor (RCP).
+ */
+
+#ifndef OT_ESP32_RCP_CLOCK_HPP_
+#define OT_ESP32_RCP_CLOCK_HPP_
+
+#include <stdint.h>
+
+#include <openthread/error.h>
+
+namespace ot {
+
+namespace Esp32 {
+
+/**
+ * This class estimates the offset and the drift between the host clock and the RCP clock.
+ *
+ * The RCP stamps every received radio frame with its own microsecond clock. Each such frame gives a sample of the
+ * offset between both clocks, biased by the time it took to reach the host. Only the lower envelope of the samples is
+ * kept, i.e. the samples with the shortest delivery time, and the drift is estimated from the lower envelope of
+ * successive windows of `kWindowDuration`.
+ *
+ */
+class RcpClock
+{
+public:
+    /**
+     * This constructor initializes the object without an estimate.
+     *
+     */
+    RcpClock(void);
+
+    /**
+     * This method drops the estimate, e.g. after the RCP has been reset and its clock has restarted.
+     *
+     */
+    void Reset(void);
+
+    /**
+     * This method takes a sample from a spinel frame received from the RCP.
+     *
+     * Only received radio frames carrying an RCP timestamp give a sample, other frames are ignored.
+     *
+     * @param[in]  aFrame     A pointer to the spinel frame.
+     * @param[in]  aLength    The length of the spinel frame.
+     * @param[in]  aHostTime  The host time in microseconds at which the RCP started sending the frame.
+     *
+     */
+    void HandleReceivedFrame(const uint8_t *aFrame, uint16_t aLength, uint64_t aHostTime);
+
+    /**
+     * This method converts an RCP time to the host time.
+     *
+     * @param[in]   aRcpTime   The RCP time in microseconds.
+     * @param[out]  aHostTime  The host time in microseconds.
+     *
+     * @retval OT_ERROR_NONE           Successfully converted the time.
+     * @retval OT_ERROR_INVALID_STATE  No frame has been received from the RCP yet.
+     *
+     */
+    otError ToHostTime(uint64_t aRcpTime, uint64_t &aHostTime) const;
+
+    /**
+     * This method converts a host time to the RCP time.
+     *
+     * @param[in]   aHostTime  The host time in microseconds.
+     * @param[out]  aRcpTime   The RCP time in microseconds.
+     *
+     * @retval OT_ERROR_NONE           Successfully converted the time.
+     * @retval OT_ERROR_INVALID_STATE  No frame has been received from the RCP yet.
+     *
+     */
+    otError ToRcpTime(uint64_t aHostTime, uint64_t &aRcpTime) const;
+
+    /**
+     * This method returns the estimated drift of the host clock relative to the RCP clock in parts per billion.
+     *
+     */
+    int32_t GetDrift(void) const { return mDrift; }
+
+private:
+    enum
+    {
+        kWindowDuration = 4000000, ///< Duration in microseconds of the windows the drift is estimated from.
+        kOctetDuration  = 32,      ///< Air time in microseconds of an IEEE 802.15.4 octet.
+        kDriftSmoothing = 2,       ///< A new drift estimate is weighted by 1/2^kDriftSmoothing.
+        kMaxDrift       = 500000,  ///< The largest credible drift in parts per billion.
+    };
+
+    int64_t GetOffset(uint64_t aHostTime) const;
+    void    AddSample(uint64_t aHostTime, int64_t aOffset);
+
+    bool     mValid;
+    uint64_t mRefTime;
+    int64_t  mRefOffset;
+    int32_t  mDrift;
+
+    bool     mHasLastWindow;
+    uint64_t mLastWindowTime;
+    int64_t  mLastWindowOffset;
+    uint64_t mWindowStart;
+    uint64_t mWindowMinTime;
+    int64_t  mWindowMinOffset;
+};
+
+} // namespace Esp32
+
+} // namespace ot
+
+#endif // OT_ESP32_RCP_CLOCK_HPP_
@@ -0,0 +1,97 @@
+/*
+ *  Copyright (c) 2020, The OpenThread Authors.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  3. Neither the name of the copyright holder nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "ring_buffer.hpp"
+
+#include <assert.h>
+#include <stddef.h>
+
+namespace ot {
+
+namespace Esp32 {
+
+RingBuffer::RingBuffer(void)
+    : mBuffer(NULL)
+    , mSize(0)
+    , mHead(0)
+    , mTail(0)
+{
+}
+
+void RingBuffer::Init(uint8_t *aBuffer, uint16_t aSize)
+{
+    assert(aSize != 0 && (aSize & (aSize - 1)) == 0);
+
+    mBuffer = aBuffer;
+    mSize   = aSize;
+    Clear();
+}
+
+void RingBuffer::Clear(void)
+{
+    mHead = 0;
+    mTail = 0;
+}
+
+uint8_t *RingBuffer::GetWritePointer(uint16_t &aLength)
+{
+    uint16_t index  = GetIndex(mTail);
+    uint16_t toWrap = static_cast<uint16_t>(mSize - index);
+    uint16_t free   = GetFreeSpace();
+
+    aLength = (free < toWrap) ? free : toWrap;
+
+    return mBuffer + index;
+}
+
+void RingBuffer::CommitWrite(uint16_t aLength)
+{
+    assert(aLength <= GetFreeSpace());
+    mTail = static_cast<uint16_t>(mTail + aLength);
+}
+
+const uint8_t *RingBuffer::GetReadPointer(uint16_t &aLength) const
+{
+    uint16_t index  = GetIndex(mHead);
+    uint16_t toWrap = static_cast<uint16_t>(mSize - index);
+    uint16_t length = GetLength();
+
+    aLength = (length < toWrap) ? length : toWrap;
+
+    return mBuffer + index;
+}
+
+void RingBuffer::CommitRead(uint16_t aLength)
+{
+    assert(aLength <= GetLength());
+    mHead = static_cast<uint16_t>(mHead + aLength);
+}
+
+} // namespace Esp32
+
+} // namespace ot
@@ -0,0 +1,149 @@
+/*
+ *  Copyright (c) 2020, The OpenThread Authors.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  3. Neither the name of the copyright holder nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef OT_ESP32_RING_BUFFER_HPP_
+#define OT_ESP32_RING_BUFFER_HPP_
+
+#include <stdint.h>
+
+namespace ot {
+
+namespace Esp32 {
+
+/**
+ * This class implements a byte ring buffer over caller provided storage.
+ *
+ * The ring buffer hands out contiguous regions for writing and reading, so that producers (e.g. a UART read) and
+ * consumers (e.g. the HDLC decoder) can work on the storage in place without an intermediate copy.
+ *
+ */
+class RingBuffer
+{
+public:
+    /**
+     * This constructor initializes the object without any storage.
+     *
+     */
+    RingBuffer(void);
+
+    /**
+     * This method attaches storage to the ring buffer and clears it.
+     *
+     * @param[in] aBuffer  A pointer to the storage.
+     * @param[in] aSize    The size of @p aBuffer in bytes, MUST be a power of two.
+     *
+     */
+    void Init(uint8_t *aBuffer, uint16_t aSize);
+
+    /**
+     * This method discards all bytes in the ring buffer.
+     *
+     */
+    void Clear(void);
+
+    /**
+     * This method indicates whether the ring buffer is empty.
+     *
+     * @retval TRUE   The ring buffer is empty.
+     * @retval FALSE  The ring buffer is not empty.
+     *
+     */
+    bool IsEmpty(void) const { return mHead == mTail; }
+
+    /**
+     * This method returns the number of bytes stored in the ring buffer.
+     *
+     * @returns The number of bytes stored in the ring buffer.
+     *
+     */
+    uint16_t GetLength(void) const { return static_cast<uint16_t>(mTail - mHead); }
+
+    /**
+     * This method returns the number of free bytes in the ring buffer.
+     *
+     * @returns The number of free bytes in the ring buffer.
+     *
+     */
+    uint16_t GetFreeSpace(void) const { return static_cast<uint16_t>(mSize - GetLength()); }
+
+    /**
+     * This method returns the largest contiguous free region of the ring buffer.
+     *
+     * @param[out] aLength  The length of the returned region, zero if the ring buffer is full.
+     *
+     * @returns A pointer to the beginning of the free region.
+     *
+     */
+    uint8_t *GetWritePointer(uint16_t &aLength);
+
+    /**
+     * This method commits bytes written to the region returned by `GetWritePointer()`.
+     *
+     * @param[in] aLength  The number of bytes written.
+     *
+     */
+    void CommitWrite(uint16_t aLength);
+
+    /**
+     * This method returns the largest contiguous region of stored bytes.
+     *
+     * @param[out] aLength  The length of the returned region, zero if the ring buffer is empty.
+     *
+     * @returns A pointer to the beginning of the stored bytes.
+     *
+     */
+    const uint8_t *GetReadPointer(uint16_t &aLength) const;
+
+    /**
+     * This method releases bytes consumed from the region returned by `GetReadPointer()`.
+     *
+     * @param[in] aLength  The number of bytes consumed.
+     *
+     */
+    void CommitRead(uint16_t aLength);
+
+private:
+    uint16_t GetIndex(uint16_t aPosition) const { return static_cast<uint16_t>(aPosition & (mSize - 1)); }
+
+    uint8_t *mBuffer;
+    uint16_t mSize;
+
+    // Free running positions, wrapped into the storage by `GetIndex()`.
+    volatile uint16_t mHead;
+    volatile uint16_t mTail;
+
+    // Non-copyable, intentionally not implemented.
+    RingBuffer(const RingBuffer &);
+    RingBuffer &operator=(const RingBuffer &);
+};
+
+} // namespace Esp32
+
+} // namespace ot
+
+#endif // OT_ESP32_RING_BUFFER_HPP_
@@ -0,0 +1,180 @@
+/*
+ *  Copyright (c) 2020, The OpenThread Authors.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  3. Neither the name of the copyright holder nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "spi_frame_link.hpp"
+
+#include <stddef.h>
+
+#include "error_handling.h"
+
+namespace ot {
+
+namespace Esp32 {
+
+SpiFrameLink::SpiFrameLink(uint16_t aAlignAllowance, uint16_t aSmallPacketSize, uint16_t aMaxFrameSize)
+    : mAlignAllowance(aAlignAllowance)
+    , mSmallPacketSize(aSmallPacketSize)
+    , mMaxFrameSize(aMaxFrameSize)
+    , mTransferLength(0)
+    , mTxLength(0)
+    , mSlaveDataLength(0)
+    , mTxPending(false)
+    , mResetPending(true)
+{
+}
+
+void SpiFrameLink::Reset(void)
+{
+    mTxPending       = false;
+    mSlaveDataLength = 0;
+    mResetPending    = true;
+}
+
+void SpiFrameLink::QueueFrame(uint16_t aLength)
+{
+    mTxLength  = aLength;
+    mTxPending = true;
+}
+
+uint16_t SpiFrameLink::PrepareTransaction(uint8_t *aTxBuffer)
+{
+    uint16_t dataLength = mTxPending ? mTxLength : 0;
+
+    mTransferLength = dataLength;
+
+    // Clock enough bytes to receive the frame announced by the RCP, small frames are received in one transaction.
+    if (mSlaveDataLength > mTransferLength)
+    {
+        mTransferLength = mSlaveDataLength;
+    }
+
+    if (mTransferLength < mSmallPacketSize)
+    {
+        mTransferLength = mSmallPacketSize;
+    }
+
+    WriteHeader(aTxBuffer, kFlagPattern | (mResetPending ? kFlagReset : 0), mTransferLength, dataLength);
+
+    return static_cast<uint16_t>(mAlignAllowance + kHeaderSize + mTransferLength);
+}
+
+otError SpiFrameLink::HandleTransaction(const uint8_t *aRxBuffer, Result &aResult)
+{
+    otError  error;
+    uint8_t  flags;
+    uint16_t slaveAcceptLength;
+    uint16_t slaveDataLength;
+
+    aResult.mSlaveReset    = false;
+    aResult.mTxDone        = false;
+    aResult.mRxDropped     = false;
+    aResult.mRxFrame       = NULL;
+    aResult.mRxFrameLength = 0;
+
+    // Skip the bytes the RCP may send before its header.
+    for (uint16_t i = 0; i < mAlignAllowance && aRxBuffer[0] == 0xff; i++)
+    {
+        aRxBuffer++;
+    }
+
+    // 0x00 and 0xff are clocked while the RCP is held in reset or not ready, neither matches the pattern.
+    SuccessOrExit(error = ParseHeader(aRxBuffer, flags, slaveAcceptLength, slaveDataLength));
+
+    mResetPending       = false;
+    aResult.mSlaveReset = (flags & kFlagReset) != 0;
+
+    if (mTxPending && slaveAcceptLength >= mTxLength)
+    {
+        mTxPending      = false;
+        aResult.mTxDone = true;
+    }
+
+    if (slaveDataLength == 0)
+    {
+        mSlaveDataLength = 0;
+    }
+    else if (slaveDataLength > mMaxFrameSize)
+    {
+        mSlaveDataLength   = 0;
+        aResult.mRxDropped = true;
+        ExitNow(error = OT_ERROR_PARSE);
+    }
+    else if (slaveDataLength <= mTransferLength)
+    {
+        mSlaveDataLength       = 0;
+        aResult.mRxFrame       = aRxBuffer + kHeaderSize;
+        aResult.mRxFrameLength = slaveDataLength;
+    }
+    else
+    {
+        // The next transaction clocks the whole frame.
+        mSlaveDataLength = slaveDataLength;
+    }
+
+exit:
+    return error;
+}
+
+void SpiFrameLink::WriteHeader(uint8_t *aBuffer, uint8_t aFlags, uint16_t aAcceptLength, uint16_t aDataLength)
+{
+    aBuffer[0] = aFlags;
+    WriteUint16(aAcceptLength, &aBuffer[1]);
+    WriteUint16(aDataLength, &aBuffer[3]);
+}
+
+otError SpiFrameLink::ParseHeader(const uint8_t *aBuffer,
+                                  uint8_t &      aFlags,
+                                  uint16_t &     aAcceptLength,
+                                  uint16_t &     aDataLength)
+{
+    otError error = OT_ERROR_NONE;
+
+    VerifyOrExit((aBuffer[0] & kFlagPatternMask) == kFlagPattern, error = OT_ERROR_PARSE);
+
+    aFlags        = aBuffer[0];
+    aAcceptLength = ReadUint16(&aBuffer[1]);
+    aDataLength   = ReadUint16(&aBuffer[3]);
+
+exit:
+    return error;
+}
+
+uint16_t SpiFrameLink::ReadUint16(const uint8_t *aBuffer)
+{
+    return static_cast<uint16_t>(aBuffer[0] | (aBuffer[1] << 8));
+}
+
+void SpiFrameLink::WriteUint16(uint16_t aValue, uint8_t *aBuffer)
+{
+    aBuffer[0] = static_cast<uint8_t>(aValue & 0xff);
+    aBuffer[1] = static_cast<uint8_t>(aValue >> 8);
+}
+
+} // namespace Esp32
+
+} // namespace ot
@@ -0,0 +1,183 @@
+/*
+ *  Copyright (c) 2020, The OpenThread Authors.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  3. Neither the name of the copyright holder nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef OT_ESP32_SPI_FRAME_LINK_HPP_
+#define OT_ESP32_SPI_FRAME_LINK_HPP_
+
+#include <stdint.h>
+
+#include <openthread/error.h>
+
+namespace ot {
+
+namespace Esp32 {
+
+/**
+ * This class implements the master side of the spinel SPI framing, independent of the SPI hardware.
+ *
+ * Every transaction starts with the 5-byte spinel SPI header in both directions: a flag byte, the number of bytes the
+ * sender accepts and the number of bytes the sender sends, followed by the payload. A frame is transferred only if
+ * the receiver accepts all of it, otherwise it is retried in a later transaction.
+ *
+ */
+class SpiFrameLink
+{
+public:
+    enum
+    {
+        kHeaderSize = 5, ///< Size of the spinel SPI header.
+    };
+
+    enum
+    {
+        kFlagReset       = 1 << 7, ///< The sender has been reset since the previous transaction.
+        kFlagPatternMask = 0x03,   ///< The bits which MUST match `kFlagPattern`.
+        kFlagPattern     = 0x02,   ///< The fixed pattern identifying a valid header.
+    };
+
+    /**
+     * This structure represents the outcome of a transaction.
+     *
+     */
+    struct Result
+    {
+        bool           mSlaveReset;    ///< The RCP has been reset since the previous transaction.
+        bool           mTxDone;        ///< The pending frame has been accepted by the RCP.
+        bool           mRxDropped;     ///< The RCP announced a frame larger than the maximum frame size.
+        const uint8_t *mRxFrame;       ///< The frame received from the RCP, NULL if none.
+        uint16_t       mRxFrameLength; ///< The length of `mRxFrame`.
+    };
+
+    /**
+     * This constructor initializes the object.
+     *
+     * @param[in] aAlignAllowance   The maximum number of 0xff bytes the RCP may send before its header.
+     * @param[in] aSmallPacketSize  The number of payload bytes clocked when polling for a frame of unknown length.
+     * @param[in] aMaxFrameSize     The maximum spinel frame size.
+     *
+     */
+    SpiFrameLink(uint16_t aAlignAllowance, uint16_t aSmallPacketSize, uint16_t aMaxFrameSize);
+
+    /**
+     * This method drops the pending frame and announces a reset to the RCP in the next transaction.
+     *
+     */
+    void Reset(void);
+
+    /**
+     * This method marks a frame as pending, its payload MUST have been written after the header of the TX buffer.
+     *
+     * @param[in] aLength  The length of the frame, at most the maximum frame size.
+     *
+     */
+    void QueueFrame(uint16_t aLength);
+
+    /**
+     * This method indicates whether a frame is waiting to be accepted by the RCP.
+     *
+     */
+    bool IsTxPending(void) const { return mTxPending; }
+
+    /**
+     * This method returns the length of the last queued frame.
+     *
+     */
+    uint16_t GetTxLength(void) const { return mTxLength; }
+
+    /**
+     * This method indicates whether the RCP announced a frame which has not been clocked yet.
+     *
+     */
+    bool IsRxPending(void) const { return mSlaveDataLength > 0; }
+
+    /**
+     * This method writes the header of the next transaction.
+     *
+     * @param[out] aTxBuffer  The TX buffer, the pending frame MUST follow the header.
+     *
+     * @returns The number of bytes to clock in the transaction.
+     *
+     */
+    uint16_t PrepareTransaction(uint8_t *aTxBuffer);
+
+    /**
+     * This method processes the bytes received in the transaction prepared by `PrepareTransaction()`.
+     *
+     * @param[in]  aRxBuffer  The bytes clocked in from the RCP.
+     * @param[out] aResult    The outcome of the transaction.
+     *
+     * @retval OT_ERROR_NONE   The transaction completed.
+     * @retval OT_ERROR_PARSE  The RCP header was invalid (the RCP is probably not ready) or the frame was dropped.
+     *
+     */
+    otError HandleTransaction(const uint8_t *aRxBuffer, Result &aResult);
+
+    /**
+     * This static method writes a spinel SPI header.
+     *
+     * @param[out] aBuffer        A pointer to at least `kHeaderSize` bytes.
+     * @param[in]  aFlags         The flag byte.
+     * @param[in]  aAcceptLength  The number of bytes the sender accepts.
+     * @param[in]  aDataLength    The number of bytes the sender sends.
+     *
+     */
+    static void WriteHeader(uint8_t *aBuffer, uint8_t aFlags, uint16_t aAcceptLength, uint16_t aDataLength);
+
+    /**
+     * This static method parses a spinel SPI header.
+     *
+     * @param[in]  aBuffer        A pointer to at least `kHeaderSize` bytes.
+     * @param[out] aFlags         The flag byte.
+     * @param[out] aAcceptLength  The number of bytes the sender accepts.
+     * @param[out] aDataLength    The number of bytes the sender sends.
+     *
+     * @retval OT_ERROR_NONE   The header is valid.
+     * @retval OT_ERROR_PARSE  The flag byte does not match the header pattern.
+     *
+     */
+    static otError ParseHeader(const uint8_t *aBuffer, uint8_t &aFlags, uint16_t &aAcceptLength, uint16_t &aDataLength);
+
+private:
+    static uint16_t ReadUint16(const uint8_t *aBuffer);
+    static void     WriteUint16(uint16_t aValue, uint8_t *aBuffer);
+
+    const uint16_t mAlignAllowance;
+    const uint16_t mSmallPacketSize;
+    const uint16_t mMaxFrameSize;
+    uint16_t       mTransferLength;
+    uint16_t       mTxLength;
+    uint16_t       mSlaveDataLength;
+    bool           mTxPending;
+    bool           mResetPending;
+};
+
+} // namespace Esp32
+
+} // namespace ot
+
+#endif // OT_ESP32_SPI_FRAME_LINK_HPP_
@@ -30,21 +30,18 @@
 
 #include "platform-esp32.h"
 
-#include <errno.h>
-#include <fcntl.h>
-#include <sys/select.h>
-#include <sys/unistd.h>
+#include <string.h>
 
 #include <driver/uart.h>
 #include <esp_heap_caps.h>
 #include <esp_log.h>
-#include <esp_vfs_dev.h>
 
 #include <openthread/platform/time.h>
 
 #include <openthread/openthread-esp32.h>
 
 #include "error_handling.h"
+#include "lib/spinel/spinel.h"
 
 namespace ot {
 
@@ -56,7 +53,33 @@ HdlcInterface::HdlcInterface(ot::Spinel::SpinelInterface::ReceiveFrameCallback a
     : mReceiveFrameCallback(aCallback)
     , mReceiveFrameContext(aCallbackContext)
     , mReceiveFrameBuffer(aFrameBuffer)
-    , mHdlcDecoder(aFrameBuffer, HandleHdlcFrame, this)
+#if OT_RADIO_RX_TASK_ENABLE
+    , mRxTaskFrameBuffer()
+    , mRxFrameQueue()
+    , mRxFrameQueueBuffer(NULL)
+    , mRxFrameSemaphore(NULL)
+    , mRxTask(NULL)
+    , mRxTaskStop(false)
+    , mDecodeFrameBuffer(mRxTaskFrameBuffer)
+#else
+    , mDecodeFrameBuffer(aFrameBuffer)
+#endif
+    , mHdlcDecoder(mDecodeFrameBuffer, HandleHdlcFrame, this)
+    , mUartRxBuffer(NULL)
+    , mUartTxBuffer(NULL)
+    , mHdlcResyncs(0)
+    , mRcpResetCount(0)
+    , mLinkStats()
+    , mLastTxFrameTime(0)
+    , mResponsePending(false)
+    , mWaitingForFrame(false)
+    , mConfig()
+    , mBaudRateState(kBaudRateIdle)
+    , mBaudRateKey(0)
+    , mBaudRateTarget(0)
+    , mBaudRate(OT_RADIO_UART_BAUD_RATE)
+    , mNegotiatedBaudRate(0)
+    , mBaudRateRecoveryPending(false)
 {
 }
 
@@ -64,42 +87,117 @@ HdlcInterface::~HdlcInterface(void)
 {
 }
 
-void HdlcInterface::Init(void)
+void HdlcInterface::ResetLinkStats(void)
 {
-    mUartRxBuffer = static_cast<uint8_t *>(heap_caps_malloc(kMaxFrameSize, MALLOC_CAP_8BIT));
+    // The RX task may be counting at the same time, the counters are cleared one by one.
+    ClearCounter(mLinkStats.mTxFrames);
+    ClearCounter(mLinkStats.mTxBytes);
+    ClearCounter(mLinkStats.mRxFrames);
+    ClearCounter(mLinkStats.mRxBytes);
+    ClearCounter(mLinkStats.mFcsErrors);
+    ClearCounter(mLinkStats.mDroppedFrames);
+    ClearCounter(mLinkStats.mWriteTimeouts);
+    // Only updated by the mainloop.
+    mLinkStats.mWriteBlockedTime = 0;
+
+    for (uint32_t &count : mLinkStats.mLatencyHistogram)
+    {
+        ClearCounter(count);
+    }
+}
+
+void HdlcInterface::AddToCounter(uint32_t &aCounter, uint32_t aValue)
+{
+    // The counters are updated by both the mainloop and the RX task.
+    __atomic_fetch_add(&aCounter, aValue, __ATOMIC_RELAXED);
+}
+
+void HdlcInterface::ClearCounter(uint32_t &aCounter)
+{
+    __atomic_store_n(&aCounter, 0, __ATOMIC_RELAXED);
+}
+
+void HdlcInterface::Init(const HdlcUartConfig &aConfig)
+{
+    mConfig = aConfig;
+
+    mUartRxBuffer = static_cast<uint8_t *>(heap_caps_malloc(kRxBufferSize, MALLOC_CAP_8BIT));
     VerifyOrDie(mUartRxBuffer != NULL, OT_EXIT_FAILURE);
+    mRxRingBuffer.Init(mUartRxBuffer, kRxBufferSize);
+
+    mUartTxBuffer = static_cast<uint8_t *>(heap_caps_malloc(kTxBufferSize, MALLOC_CAP_8BIT));
+    VerifyOrDie(mUartTxBuffer != NULL, OT_EXIT_FAILURE);
+    mTxRingBuffer.Init(mUartTxBuffer, kTxBufferSize);
 
     InitUart();
+
+#if OT_RADIO_RX_TASK_ENABLE
+    StartRxTask();
+#endif
 }
 
 void HdlcInterface::Deinit(void)
 {
+#if OT_RADIO_RX_TASK_ENABLE
+    StopRxTask();
+#endif
+
     DeinitUart();
 
+    mRxRingBuffer.Clear();
     heap_caps_free(mUartRxBuffer);
     mUartRxBuffer = NULL;
+
+    mTxRingBuffer.Clear();
+    heap_caps_free(mUartTxBuffer);
+    mUartTxBuffer = NULL;
 }
 
 otError HdlcInterface::SendFrame(const uint8_t *aFrame, uint16_t aLength)
 {
-    otError                              error = OT_ERROR_NONE;
-    ot::Hdlc::FrameBuffer<kMaxFrameSize> encoderBuffer;
-    ot::Hdlc::Encoder                    hdlcEncoder(encoderBuffer);
+    otError     error = OT_ERROR_NONE;
+    uint8_t     chunk[kTxChunkSize];
+    uint16_t    used;
+    HdlcEncoder hdlcEncoder;
+
+    used = hdlcEncoder.BeginFrame(chunk);
+
+    // Escape the frame in chunks and queue each of them, the head of the queue is written to the UART FIFO which
+    // is transmitted while the next chunk is being encoded.
+    while (aLength > 0)
+    {
+        uint16_t written  = static_cast<uint16_t>(sizeof(chunk) - used);
+        uint16_t consumed = hdlcEncoder.Encode(aFrame, aLength, chunk + used, written);
 
-    SuccessOrExit(error = hdlcEncoder.BeginFrame());
-    SuccessOrExit(error = hdlcEncoder.Encode(aFrame, aLength));
-    SuccessOrExit(error = hdlcEncoder.EndFrame());
+        aFrame += consumed;
+        aLength -= consumed;
+        used += written;
 
-    SuccessOrExit(error = Write(encoderBuffer.GetFrame(), encoderBuffer.GetLength()));
+        if (aLength > 0 || sizeof(chunk) - used < HdlcEncoder::kMaxEndFrameSize)
+        {
+            SuccessOrExit(error = Write(chunk, used));
+            used = 0;
+        }
+    }
+
+    used += hdlcEncoder.EndFrame(chunk + used);
+    SuccessOrExit(error = Write(chunk, used));
+
+    FlushTxQueue();
+
+    AddToCounter(mLinkStats.mTxFrames, 1);
+    mLastTxFrameTime = otPlatTimeGet();
+    mResponsePending = true;
 
 exit:
     if (error != OT_ERROR_NONE)
     {
         ESP_LOGE(OT_PLAT_LOG_TAG, "send radio frame failed");
+        AddToCounter(mLinkStats.mWriteTimeouts, 1);
     }
     else
     {
-        ESP_LOGD(OT_PLAT_LOG_TAG, "sent radio frame\n");
+        ESP_LOGD(OT_PLAT_LOG_TAG, "queued radio frame\n");
     }
 
     return error;
@@ -107,98 +205,145 @@ exit:
 
 void HdlcInterface::Process(const otSysMainloopContext &aMainloop)
 {
-    if (FD_ISSET(mUartFd, &aMainloop.mReadFdSet))
+    OT_UNUSED_VARIABLE(aMainloop);
+
+    if (platformVfsEventIsSignaled(mConfig.mEvent))
     {
         ESP_LOGD(OT_PLAT_LOG_TAG, "radio uart read event");
+#if OT_RADIO_RX_TASK_ENABLE
+        HandleQueuedFrames();
+#else
+        HandleUartErrors();
         TryReadAndDecode();
+#endif
+    }
+
+    if (!mTxRingBuffer.IsEmpty())
+    {
+        FlushTxQueue();
+    }
+
+    if (mBaudRateRecoveryPending)
+    {
+        RecoverBaudRate();
     }
 }
 
 void HdlcInterface::Update(otSysMainloopContext &aMainloop)
 {
-    // Register only READ events for radio UART and always wait
-    // for a radio WRITE to complete.
-    FD_SET(mUartFd, &aMainloop.mReadFdSet);
-    if (mUartFd > aMainloop.mMaxFd)
+    uint64_t wait;
+
+    VerifyOrExit(!mTxRingBuffer.IsEmpty(), OT_NOOP);
+
+    // The UART driver does not signal free FIFO space, wake up once half of the FIFO may have been transmitted.
+    wait = GetTxTime(kTxFifoSize / 2);
+
+    if (wait < static_cast<uint64_t>(aMainloop.mTimeout.tv_sec) * OT_US_PER_S + aMainloop.mTimeout.tv_usec)
     {
-        aMainloop.mMaxFd = mUartFd;
+        aMainloop.mTimeout.tv_sec  = static_cast<time_t>(wait / OT_US_PER_S);
+        aMainloop.mTimeout.tv_usec = static_cast<suseconds_t>(wait % OT_US_PER_S);
     }
+
+exit:
+    return;
 }
 
 int HdlcInterface::TryReadAndDecode(void)
 {
-    uint8_t buffer[kMaxFrameSize];
-    ssize_t rval;
+    int total = 0;
 
-    rval = read(mUartFd, buffer, sizeof(buffer));
+    platformUartEventSampleRxLevel(mConfig.mPort);
 
-    if (rval > 0)
-    {
-        mHdlcDecoder.Decode(buffer, static_cast<uint16_t>(rval));
-    }
-    else if ((rval < 0) && (errno != EAGAIN) && (errno != EINTR))
+    while (true)
     {
-        abort();
+        uint16_t length;
+        uint8_t *buffer = mRxRingBuffer.GetWritePointer(length);
+        int      rval   = uart_read_bytes(mConfig.mPort, buffer, length, 0);
+
+        VerifyOrDie(rval >= 0, OT_EXIT_FAILURE);
+
+        if (rval == 0)
+        {
+            // The UART driver has been drained.
+            break;
+        }
+
+        mRxRingBuffer.CommitWrite(static_cast<uint16_t>(rval));
+        total += rval;
+        DecodeRxBuffer();
     }
 
-    return rval;
+    return total;
 }
 
-otError HdlcInterface::WaitForWritable(void)
+void HdlcInterface::HandleUartErrors(void)
 {
-    otError        error   = OT_ERROR_NONE;
-    struct timeval timeout = {kMaxWaitTime / OT_MS_PER_S, (kMaxWaitTime % OT_MS_PER_S) * OT_US_PER_MS};
-    uint64_t       now     = otPlatTimeGet();
-    uint64_t       end     = now + kMaxWaitTime * OT_US_PER_MS;
-    fd_set         writeFds;
-    fd_set         errorFds;
-    int            rval;
+    uint32_t errors = platformUartEventTakeErrors(mConfig.mPort);
 
-    while (true)
+    if (errors & OT_UART_ERROR_FIFO_OVF)
     {
-        FD_ZERO(&writeFds);
-        FD_ZERO(&errorFds);
-        FD_SET(mUartFd, &writeFds);
-        FD_SET(mUartFd, &errorFds);
+        // Bytes have been lost at an unknown position, the buffered bytes can not be trusted to form valid frames.
+        ESP_LOGW(OT_PLAT_LOG_TAG, "radio uart fifo overflow");
+        uart_flush_input(mConfig.mPort);
+        mRxRingBuffer.Clear();
+        mHdlcDecoder.Reset();
+        mDecodeFrameBuffer.DiscardFrame();
+        AddToCounter(mHdlcResyncs, 1);
+    }
 
-        rval = select(mUartFd + 1, NULL, &writeFds, &errorFds, &timeout);
+    if (errors & OT_UART_ERROR_FRAME)
+    {
+        // The corrupted frame is dropped by the FCS check. Framing errors are also what an RCP which has been reset
+        // back to the default baud rate looks like.
+        ESP_LOGW(OT_PLAT_LOG_TAG, "radio uart frame error");
 
-        if (rval > 0)
+        if (mNegotiatedBaudRate != 0 && mBaudRate != mConfig.mBaudRate)
         {
-            if (FD_ISSET(mUartFd, &writeFds))
-            {
-                ExitNow();
-            }
-            else if (FD_ISSET(mUartFd, &errorFds))
-            {
-                VerifyOrDie(false, OT_EXIT_FAILURE);
-            }
-            else
-            {
-                assert(false);
-            }
-        }
-        else if ((rval < 0) && (errno != EINTR))
-        {
-            VerifyOrDie(false, OT_EXIT_FAILURE);
+            mBaudRateRecoveryPending = true;
         }
+    }
+}
 
-        now = otPlatTimeGet();
+void HdlcInterface::DecodeRxBuffer(void)
+{
+    while (!mRxRingBuffer.IsEmpty())
+    {
+        uint16_t       length;
+        const uint8_t *data = mRxRingBuffer.GetReadPointer(length);
 
-        if (end > now)
-        {
-            uint64_t remain = end - now;
+        AddToCounter(mLinkStats.mRxBytes, length);
+        mHdlcDecoder.Decode(data, length);
+        mRxRingBuffer.CommitRead(length);
+    }
+}
 
-            timeout.tv_sec  = static_cast<time_t>(remain / 1000000);
-            timeout.tv_usec = static_cast<suseconds_t>(remain % 1000000);
-        }
-        else
-        {
-            break;
-        }
+otError HdlcInterface::WaitForWritable(void)
+{
+    otError  error = OT_ERROR_NONE;
+    uint64_t start = otPlatTimeGet();
+
+    FlushTxQueue();
+    VerifyOrExit(uart_wait_tx_done(mConfig.mPort, pdMS_TO_TICKS(kMaxWaitTime)) == ESP_OK,
+                 error = OT_ERROR_FAILED);
+    FlushTxQueue();
+
+exit:
+    mLinkStats.mWriteBlockedTime += otPlatTimeGet() - start;
+    return error;
+}
+
+otError HdlcInterface::WaitForTxDone(void)
+{
+    otError error = OT_ERROR_NONE;
+
+    // Every round transmits a full FIFO, or gives up.
+    while (!mTxRingBuffer.IsEmpty())
+    {
+        SuccessOrExit(error = WaitForWritable());
     }
 
-    error = OT_ERROR_FAILED;
+    VerifyOrExit(uart_wait_tx_done(mConfig.mPort, pdMS_TO_TICKS(kMaxWaitTime)) == ESP_OK,
+                 error = OT_ERROR_FAILED);
 
 exit:
     return error;
@@ -208,135 +353,536 @@ otError HdlcInterface::Write(const uint8_t *aFrame, uint16_t aLength)
 {
     otError error = OT_ERROR_NONE;
 
-    while (aLength)
+    while (aLength > 0)
     {
-        ssize_t rval;
-
-        // Configure ESP-IDF UART to never convert "\n" to "\r\n" just before
-        // writing radio frames through UART. This is a workaround for issue:
-        // https://github.com/openthread/ot-esp32/issues/5.
-        esp_vfs_dev_uart_set_tx_line_endings(ESP_LINE_ENDINGS_LF);
-        rval = write(mUartFd, aFrame, aLength);
-        esp_vfs_dev_uart_set_tx_line_endings(ESP_LINE_ENDINGS_CRLF);
+        uint16_t length;
+        uint8_t *buffer = mTxRingBuffer.GetWritePointer(length);
 
-        if (rval > 0)
+        if (length == 0)
         {
-            assert(rval <= aLength);
-            aLength -= static_cast<uint16_t>(rval);
-            aFrame += static_cast<uint16_t>(rval);
+            // The TX queue is full, wait for the UART to drain part of it.
+            SuccessOrExit(error = WaitForWritable());
             continue;
         }
 
-        if ((rval < 0) && (errno != EAGAIN) && (errno != EWOULDBLOCK) && (errno != EINTR))
+        if (length > aLength)
         {
-            abort();
+            length = aLength;
         }
 
-        SuccessOrExit(error = WaitForWritable());
+        memcpy(buffer, aFrame, length);
+        mTxRingBuffer.CommitWrite(length);
+        AddToCounter(mLinkStats.mTxBytes, length);
+        aFrame += length;
+        aLength -= length;
     }
 
 exit:
     return error;
 }
 
+void HdlcInterface::FlushTxQueue(void)
+{
+    while (!mTxRingBuffer.IsEmpty())
+    {
+        uint16_t       length;
+        const uint8_t *data = mTxRingBuffer.GetReadPointer(length);
+        int            rval;
+
+        // Only fills the free space of the FIFO, the bytes are written as they are without line ending conversion.
+        rval = uart_tx_chars(mConfig.mPort, reinterpret_cast<const char *>(data), length);
+        VerifyOrExit(rval > 0, OT_NOOP);
+
+        mTxRingBuffer.CommitRead(static_cast<uint16_t>(rval));
+        VerifyOrExit(rval == length, OT_NOOP);
+    }
+
+exit:
+    return;
+}
+
+bool HdlcInterface::IsIdle(void) const
+{
+    // The FIFO is not transmitted while the RCP holds CTS, only the driver knows when it is.
+    return mTxRingBuffer.IsEmpty() && uart_wait_tx_done(mConfig.mPort, 0) == ESP_OK;
+}
+
+uint64_t HdlcInterface::GetTxTime(uint32_t aLength) const
+{
+    return static_cast<uint64_t>(aLength) * kUartBitsPerByte * OT_US_PER_S / mBaudRate;
+}
+
 otError HdlcInterface::WaitForFrame(uint64_t aTimeoutUs)
 {
-    otError        error = OT_ERROR_NONE;
-    struct timeval timeout;
-    fd_set         read_fds;
-    fd_set         error_fds;
-    int            rval;
+    otError  error = OT_ERROR_NONE;
+    uint64_t end   = otPlatTimeGet() + aTimeoutUs;
+
+    // Frames completed while waiting are responses to the last frame sent.
+    mWaitingForFrame = true;
+
+    while (true)
+    {
+        uint64_t now = otPlatTimeGet();
+        uint64_t wait;
+
+        // The request being waited for may still be queued, keep flushing it.
+        FlushTxQueue();
+
+#if OT_RADIO_RX_TASK_ENABLE
+        VerifyOrExit(!HandleQueuedFrames(), OT_NOOP);
+#else
+        HandleUartErrors();
+        VerifyOrExit(TryReadAndDecode() == 0, OT_NOOP);
+#endif
+        VerifyOrExit(now < end, error = OT_ERROR_RESPONSE_TIMEOUT);
+
+        wait = end - now;
+
+        if (!mTxRingBuffer.IsEmpty() && wait > GetTxTime(kTxFifoSize / 2))
+        {
+            wait = GetTxTime(kTxFifoSize / 2);
+        }
 
-    FD_ZERO(&read_fds);
-    FD_ZERO(&error_fds);
-    FD_SET(mUartFd, &read_fds);
-    FD_SET(mUartFd, &error_fds);
+#if OT_RADIO_RX_TASK_ENABLE
+        // Block until the RX task has queued a frame, at least for one tick.
+        xSemaphoreTake(mRxFrameSemaphore, pdMS_TO_TICKS(wait / OT_US_PER_MS) + 1);
+#else
+        {
+            uint16_t length;
+            uint8_t *buffer = mRxRingBuffer.GetWritePointer(length);
+            int      rval;
+
+            // Block in the UART driver until the first byte arrives, at least for one tick.
+            rval = uart_read_bytes(mConfig.mPort, buffer, 1, pdMS_TO_TICKS(wait / OT_US_PER_MS) + 1);
+            VerifyOrDie(rval >= 0, OT_EXIT_FAILURE);
+
+            if (rval > 0)
+            {
+                mRxRingBuffer.CommitWrite(static_cast<uint16_t>(rval));
+                DecodeRxBuffer();
+                TryReadAndDecode();
+                ExitNow();
+            }
+        }
+#endif
+    }
 
-    timeout.tv_sec  = static_cast<time_t>(aTimeoutUs / OT_US_PER_S);
-    timeout.tv_usec = static_cast<suseconds_t>(aTimeoutUs % OT_US_PER_S);
+exit:
+    if (error == OT_ERROR_RESPONSE_TIMEOUT && mBaudRateState == kBaudRateIdle && mNegotiatedBaudRate != 0)
+    {
+        // The RCP may have been reset back to the default baud rate, its reset notification is unreadable then.
+        mBaudRateRecoveryPending = true;
+    }
+
+    mWaitingForFrame = false;
+    return error;
+}
+
+void HdlcInterface::HandleHdlcFrame(void *aContext, otError aError)
+{
+    static_cast<HdlcInterface *>(aContext)->HandleHdlcFrame(aError);
+}
+
+void HdlcInterface::HandleHdlcFrame(otError aError)
+{
+    if (aError == OT_ERROR_NONE)
+    {
+        // The frame has been on the wire before it was decoded.
+        uint64_t receiveTime = otPlatTimeGet() - GetTxTime(mDecodeFrameBuffer.GetLength());
+
+        AddToCounter(mLinkStats.mRxFrames, 1);
+
+#if OT_RADIO_RX_TASK_ENABLE
+        QueueFrame(receiveTime);
+#else
+        HandleReceivedFrame(receiveTime);
+#endif
+    }
+    else
+    {
+        if (aError == OT_ERROR_PARSE)
+        {
+            AddToCounter(mLinkStats.mFcsErrors, 1);
+        }
+        else
+        {
+            AddToCounter(mLinkStats.mDroppedFrames, 1);
+        }
+
+        ESP_LOGE(OT_PLAT_LOG_TAG, "dropping radio frame: %s\n", otThreadErrorToString(aError));
+        mDecodeFrameBuffer.DiscardFrame();
+        AddToCounter(mHdlcResyncs, 1);
+    }
+}
 
-    rval = select(mUartFd + 1, &read_fds, NULL, &error_fds, &timeout);
+void HdlcInterface::HandleReceivedFrame(uint64_t aReceiveTime)
+{
+    RecordLatency();
 
-    if (rval > 0)
+    if (mBaudRateState == kBaudRatePending &&
+        HandleBaudRateResponse(mReceiveFrameBuffer.GetFrame(), mReceiveFrameBuffer.GetLength()))
+    {
+        mReceiveFrameBuffer.DiscardFrame();
+    }
+    else
     {
-        if (FD_ISSET(mUartFd, &read_fds))
+        ESP_LOGD(OT_PLAT_LOG_TAG, "received hdlc radio frame\n");
+
+        if (IsRcpResetFrame(mReceiveFrameBuffer.GetFrame(), mReceiveFrameBuffer.GetLength()))
         {
-            TryReadAndDecode();
+            mRcpResetCount++;
+            mRcpClock.Reset();
+
+            // The RCP keeps a negotiated baud rate across spinel resets, not across hardware resets.
+            if (mNegotiatedBaudRate != 0 && mBaudRate == mConfig.mBaudRate)
+            {
+                mBaudRateRecoveryPending = true;
+            }
         }
-        else if (FD_ISSET(mUartFd, &error_fds))
+        else
+        {
+            mRcpClock.HandleReceivedFrame(mReceiveFrameBuffer.GetFrame(), mReceiveFrameBuffer.GetLength(),
+                                          aReceiveTime);
+        }
+
+        mReceiveFrameCallback(mReceiveFrameContext);
+    }
+}
+
+#if OT_RADIO_RX_TASK_ENABLE
+void HdlcInterface::QueueFrame(uint64_t aReceiveTime)
+{
+    if (!mRxFrameQueue.Push(mDecodeFrameBuffer.GetFrame(), mDecodeFrameBuffer.GetLength(), aReceiveTime))
+    {
+        ESP_LOGW(OT_PLAT_LOG_TAG, "radio rx queue full, dropping radio frame");
+        AddToCounter(mLinkStats.mDroppedFrames, 1);
+    }
+
+    mDecodeFrameBuffer.DiscardFrame();
+
+    platformVfsEventSignal(mConfig.mEvent);
+    xSemaphoreGive(mRxFrameSemaphore);
+}
+
+bool HdlcInterface::HandleQueuedFrames(void)
+{
+    bool     handled = false;
+    uint64_t receiveTime;
+    otError  error;
+
+    while ((error = mRxFrameQueue.Pop(mReceiveFrameBuffer, receiveTime)) != OT_ERROR_NOT_FOUND)
+    {
+        if (error == OT_ERROR_NONE)
         {
-            abort();
+            HandleReceivedFrame(receiveTime);
+            handled = true;
         }
         else
         {
-            abort();
+            ESP_LOGE(OT_PLAT_LOG_TAG, "dropping radio frame: %s\n", otThreadErrorToString(error));
         }
     }
-    else if (rval == 0)
+
+    return handled;
+}
+
+void HdlcInterface::StartRxTask(void)
+{
+    TaskHandle_t task;
+    BaseType_t   ret;
+
+    mRxFrameQueueBuffer = static_cast<uint8_t *>(heap_caps_malloc(OT_RADIO_RX_QUEUE_SIZE, MALLOC_CAP_8BIT));
+    VerifyOrDie(mRxFrameQueueBuffer != NULL, OT_EXIT_FAILURE);
+    mRxFrameQueue.Init(mRxFrameQueueBuffer, OT_RADIO_RX_QUEUE_SIZE);
+
+    mRxFrameSemaphore = xSemaphoreCreateBinary();
+    VerifyOrDie(mRxFrameSemaphore != NULL, OT_EXIT_FAILURE);
+
+    mRxTaskStop = false;
+
+    ret = xTaskCreatePinnedToCore(RxTask, "ot_radio_rx", OT_RADIO_RX_TASK_STACK_SIZE, this, OT_RADIO_RX_TASK_PRIORITY,
+                                  &task, OT_RADIO_RX_TASK_CORE);
+    VerifyOrDie(ret == pdPASS, OT_EXIT_FAILURE);
+    mRxTask = task;
+
+    // From now on the RX task owns the uart reception and the HDLC decoder.
+    platformUartEventSetTask(mConfig.mPort, task);
+    xTaskNotifyGive(task);
+}
+
+void HdlcInterface::StopRxTask(void)
+{
+    platformUartEventSetTask(mConfig.mPort, NULL);
+
+    mRxTaskStop = true;
+    xTaskNotifyGive(mRxTask);
+
+    while (mRxTask != NULL)
     {
-        ExitNow(error = OT_ERROR_RESPONSE_TIMEOUT);
+        vTaskDelay(1);
     }
-    else if (errno != EINTR)
+
+    mRxFrameQueue.Clear();
+    heap_caps_free(mRxFrameQueueBuffer);
+    mRxFrameQueueBuffer = NULL;
+
+    vSemaphoreDelete(mRxFrameSemaphore);
+    mRxFrameSemaphore = NULL;
+}
+
+void HdlcInterface::RxTask(void *aContext)
+{
+    static_cast<HdlcInterface *>(aContext)->RxTask();
+    vTaskDelete(NULL);
+}
+
+void HdlcInterface::RxTask(void)
+{
+    while (!mRxTaskStop)
     {
-        abort();
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        HandleUartErrors();
+        TryReadAndDecode();
     }
 
+    // The interface may be deinitialized as soon as this is seen.
+    mRxTask = NULL;
+}
+#endif // OT_RADIO_RX_TASK_ENABLE
+
+void HdlcInterface::RecordLatency(void)
+{
+    uint64_t latency;
+    uint8_t  bucket = 0;
+
+    VerifyOrExit(mWaitingForFrame && mResponsePending, OT_NOOP);
+    mResponsePending = false;
+
+    latency = (otPlatTimeGet() - mLastTxFrameTime) / OT_US_PER_MS;
+
+    while (latency > 0 && bucket < OT_SYS_RCP_LATENCY_BUCKETS - 1)
+    {
+        latency >>= 1;
+        bucket++;
+    }
+
+    AddToCounter(mLinkStats.mLatencyHistogram[bucket], 1);
+
 exit:
+    return;
+}
+
+bool HdlcInterface::IsRcpResetFrame(const uint8_t *aFrame, uint16_t aLength)
+{
+    uint8_t           header;
+    unsigned int      command;
+    spinel_prop_key_t key;
+    unsigned int      status;
+    spinel_ssize_t    unpacked;
+
+    unpacked = spinel_datatype_unpack(aFrame, aLength, SPINEL_DATATYPE_COMMAND_PROP_S SPINEL_DATATYPE_UINT_PACKED_S,
+                                      &header, &command, &key, &status);
+
+    return unpacked > 0 && command == SPINEL_CMD_PROP_VALUE_IS && key == SPINEL_PROP_LAST_STATUS &&
+           status >= SPINEL_STATUS_RESET__BEGIN && status < SPINEL_STATUS_RESET__END;
+}
+
+bool HdlcInterface::HandleBaudRateResponse(const uint8_t *aFrame, uint16_t aLength)
+{
+    bool              handled = false;
+    uint8_t           header;
+    unsigned int      command;
+    spinel_prop_key_t key;
+    const uint8_t *   data;
+    spinel_size_t     dataLength;
+    spinel_ssize_t    unpacked;
+
+    unpacked = spinel_datatype_unpack(aFrame, aLength, SPINEL_DATATYPE_COMMAND_PROP_S SPINEL_DATATYPE_DATA_S, &header,
+                                      &command, &key, &data, &dataLength);
+
+    VerifyOrExit(unpacked > 0 && SPINEL_HEADER_GET_TID(header) == kBaudRateTid, OT_NOOP);
+    VerifyOrExit(command == SPINEL_CMD_PROP_VALUE_IS, OT_NOOP);
+
+    handled        = true;
+    mBaudRateState = kBaudRateRejected;
+
+    // A LAST_STATUS answer means the RCP does not support the request.
+    VerifyOrExit(key == mBaudRateKey, OT_NOOP);
+
+    if (key == OT_RADIO_SPINEL_PROP_UART_BAUD_RATE)
+    {
+        uint32_t baudRate;
+
+        unpacked = spinel_datatype_unpack(data, dataLength, SPINEL_DATATYPE_UINT32_S, &baudRate);
+
+        if (unpacked > 0 && baudRate == mBaudRateTarget)
+        {
+            mBaudRateState = kBaudRateAccepted;
+        }
+    }
+    else
+    {
+        // Any answer to the probe proves the RCP is talking at the probed baud rate.
+        mBaudRateState = kBaudRateAccepted;
+    }
+
+exit:
+    return handled;
+}
+
+otError HdlcInterface::SendBaudRateRequest(uint8_t aCommand, uint32_t aKey, uint32_t aBaudRate)
+{
+    otError        error = OT_ERROR_NONE;
+    uint8_t        frame[16];
+    spinel_ssize_t length;
+    uint64_t       end;
+
+    if (aCommand == SPINEL_CMD_PROP_VALUE_SET)
+    {
+        length = spinel_datatype_pack(frame, sizeof(frame), SPINEL_DATATYPE_COMMAND_PROP_S SPINEL_DATATYPE_UINT32_S,
+                                      SPINEL_HEADER_FLAG | SPINEL_HEADER_IID_0 | kBaudRateTid, aCommand, aKey,
+                                      aBaudRate);
+    }
+    else
+    {
+        length = spinel_datatype_pack(frame, sizeof(frame), SPINEL_DATATYPE_COMMAND_PROP_S,
+                                      SPINEL_HEADER_FLAG | SPINEL_HEADER_IID_0 | kBaudRateTid, aCommand, aKey);
+    }
+
+    VerifyOrExit(length > 0 && static_cast<size_t>(length) <= sizeof(frame), error = OT_ERROR_FAILED);
+
+    mBaudRateKey    = aKey;
+    mBaudRateTarget = aBaudRate;
+    mBaudRateState  = kBaudRatePending;
+    SuccessOrExit(error = SendFrame(frame, static_cast<uint16_t>(length)));
+
+    end = otPlatTimeGet() + kBaudRateResponseTimeout * OT_US_PER_MS;
+
+    while (mBaudRateState == kBaudRatePending)
+    {
+        uint64_t now = otPlatTimeGet();
+
+        VerifyOrExit(now < end, error = OT_ERROR_RESPONSE_TIMEOUT);
+        WaitForFrame(end - now);
+    }
+
+    VerifyOrExit(mBaudRateState == kBaudRateAccepted, error = OT_ERROR_NOT_IMPLEMENTED);
+
+exit:
+    mBaudRateState = kBaudRateIdle;
     return error;
 }
 
-void HdlcInterface::HandleHdlcFrame(void *aContext, otError aError)
+otError HdlcInterface::SetUartBaudRate(uint32_t aBaudRate)
 {
-    static_cast<HdlcInterface *>(aContext)->HandleHdlcFrame(aError);
+    otError error = OT_ERROR_NONE;
+
+    // Whatever is still queued has to go out at the baud rate it was meant for.
+    SuccessOrExit(error = WaitForTxDone());
+    VerifyOrExit(uart_set_baudrate(mConfig.mPort, aBaudRate) == ESP_OK, error = OT_ERROR_FAILED);
+
+    mBaudRate = aBaudRate;
+
+exit:
+    return error;
 }
 
-void HdlcInterface::HandleHdlcFrame(otError aError)
+otError HdlcInterface::NegotiateBaudRate(uint32_t aBaudRate)
 {
-    if (aError == OT_ERROR_NONE)
+    otError  error   = OT_ERROR_NONE;
+    uint32_t current = mBaudRate;
+
+    // Remembered, so that the link can be renegotiated after the RCP has been reset.
+    mNegotiatedBaudRate = aBaudRate;
+
+    VerifyOrExit(aBaudRate != current, OT_NOOP);
+
+    error = SendBaudRateRequest(SPINEL_CMD_PROP_VALUE_SET, OT_RADIO_SPINEL_PROP_UART_BAUD_RATE, aBaudRate);
+
+    if (error == OT_ERROR_RESPONSE_TIMEOUT)
     {
-        ESP_LOGD(OT_PLAT_LOG_TAG, "received hdlc radio frame\n");
-        mReceiveFrameCallback(mReceiveFrameContext);
+        // The RCP may already run at the requested baud rate, or may have switched without its answer getting through.
+        SuccessOrExit(error = SetUartBaudRate(aBaudRate));
+
+        if (SendBaudRateRequest(SPINEL_CMD_PROP_VALUE_GET, SPINEL_PROP_PROTOCOL_VERSION, aBaudRate) == OT_ERROR_NONE)
+        {
+            ExitNow(error = OT_ERROR_NONE);
+        }
+
+        // The RCP is at neither baud rate or does not answer at all, the recovery tries again on the next timeout.
+        SetUartBaudRate(current);
+        ExitNow();
+    }
+
+    SuccessOrExit(error);
+
+    // The RCP switches once its response has been sent, the local UART follows.
+    error = SetUartBaudRate(aBaudRate);
+
+exit:
+    if (error == OT_ERROR_NONE)
+    {
+        // Framing errors seen while switching do not call for a recovery.
+        mBaudRateRecoveryPending = false;
+        ESP_LOGI(OT_PLAT_LOG_TAG, "radio uart %d running at %u baud", mConfig.mPort, mBaudRate);
     }
     else
     {
-        ESP_LOGE(OT_PLAT_LOG_TAG, "dropping radio frame: %s\n", otThreadErrorToString(aError));
-        mReceiveFrameBuffer.DiscardFrame();
+        if (error == OT_ERROR_NOT_IMPLEMENTED)
+        {
+            mNegotiatedBaudRate = 0;
+        }
+
+        ESP_LOGW(OT_PLAT_LOG_TAG, "radio uart %d stays at %u baud: %s", mConfig.mPort, mBaudRate,
+                 otThreadErrorToString(error));
     }
+
+    return error;
+}
+
+void HdlcInterface::RecoverBaudRate(void)
+{
+    mBaudRateRecoveryPending = false;
+
+    ESP_LOGW(OT_PLAT_LOG_TAG, "radio uart %d lost the RCP at %u baud, renegotiating", mConfig.mPort, mBaudRate);
+
+    // A hardware reset brings the RCP back at the default baud rate, the request is sent from there. If the RCP still
+    // runs at the negotiated baud rate, it is found by the probe of NegotiateBaudRate().
+    SuccessOrExit(SetUartBaudRate(mConfig.mBaudRate));
+    NegotiateBaudRate(mNegotiatedBaudRate);
+
+exit:
+    return;
 }
 
 void HdlcInterface::InitUart(void)
 {
-    char          uartPath[16];
-    uart_config_t uart_config = {.baud_rate           = 115200,
+    QueueHandle_t eventQueue;
+    // Clocked by the APB, power management keeps it at its maximum while the RCP is busy, see platformRadioIsIdle().
+    uart_config_t uart_config = {.baud_rate           = static_cast<int>(mConfig.mBaudRate),
                                  .data_bits           = UART_DATA_8_BITS,
                                  .parity              = UART_PARITY_DISABLE,
                                  .stop_bits           = UART_STOP_BITS_1,
-                                 .flow_ctrl           = UART_HW_FLOWCTRL_DISABLE,
-                                 .rx_flow_ctrl_thresh = 0,
+                                 .flow_ctrl           = mConfig.mFlowCtrl,
+                                 .rx_flow_ctrl_thresh = OT_RADIO_UART_RX_FLOW_CTRL_THRESH,
                                  .use_ref_tick        = false};
 
-    ESP_ERROR_CHECK(uart_param_config(OT_RADIO_UART_NUM, &uart_config));
+    ESP_ERROR_CHECK(uart_param_config(mConfig.mPort, &uart_config));
+    ESP_ERROR_CHECK(uart_set_pin(mConfig.mPort, mConfig.mTxdPin, mConfig.mRxdPin, mConfig.mRtsPin, mConfig.mCtsPin));
+    // Without a TX ring buffer, the driver never blocks the writer, the TX queue is written to the FIFO directly.
     ESP_ERROR_CHECK(
-        uart_set_pin(OT_RADIO_UART_NUM, OT_RADIO_UART_TXD, OT_RADIO_UART_RXD, UART_PIN_NO_CHANGE, UART_PIN_NO_CHANGE));
-    ESP_ERROR_CHECK(uart_driver_install(OT_RADIO_UART_NUM, OT_UART_RX_BUF_SIZE, 0, 0, NULL, 0));
-
-    // We have a driver now installed so set up the read/write functions to use driver also.
-    esp_vfs_dev_uart_use_driver(OT_RADIO_UART_NUM);
+        uart_driver_install(mConfig.mPort, OT_RADIO_UART_RX_BUF_SIZE, 0, OT_UART_EVENT_QUEUE_SIZE, &eventQueue, 0));
 
-    sprintf(uartPath, "/dev/uart/%d", OT_RADIO_UART_NUM);
-    mUartFd = open(uartPath, O_RDWR | O_NONBLOCK);
+    // The radio UART is a raw binary link, it is accessed through the driver and bypasses the VFS entirely.
+    platformUartEventAdd(mConfig.mPort, eventQueue, mConfig.mEvent);
 
-    VerifyOrDie(mUartFd != -1, OT_EXIT_FAILURE);
+    mBaudRate = mConfig.mBaudRate;
 }
 
 void HdlcInterface::DeinitUart(void)
 {
-    if (mUartFd != -1)
-    {
-        close(mUartFd);
-        mUartFd = -1;
-    }
-    ESP_ERROR_CHECK(uart_driver_delete(OT_RADIO_UART_NUM));
+    platformUartEventRemove(mConfig.mPort);
+    ESP_ERROR_CHECK(uart_driver_delete(mConfig.mPort));
 }
 
 } // namespace Esp32
@@ -35,12 +35,34 @@
 
 #include "lib/spinel/spinel_interface.hpp"
 
+#include "frame_queue.hpp"
+#include "hdlc_codec.hpp"
+#include "platform-esp32.h"
+#include "rcp_clock.hpp"
+#include "ring_buffer.hpp"
+
 namespace ot {
 
 namespace Esp32 {
 
 typedef uint8_t HdlcSpinelContext;
 
+/**
+ * This structure represents the uart connecting the host to a Radio Co-processor (RCP).
+ *
+ */
+struct HdlcUartConfig
+{
+    uart_port_t           mPort;     ///< The uart port.
+    int                   mTxdPin;   ///< The TXD pin.
+    int                   mRxdPin;   ///< The RXD pin.
+    int                   mRtsPin;   ///< The RTS pin, only used with hardware flow control.
+    int                   mCtsPin;   ///< The CTS pin, only used with hardware flow control.
+    uart_hw_flowcontrol_t mFlowCtrl; ///< The hardware flow control mode.
+    uint32_t              mBaudRate; ///< The baud rate after reset.
+    uint32_t              mEvent;    ///< The OT_EVENT_* event signaled when the uart has received data.
+};
+
 /**
  * This class defines an HDLC spinel interface to the Radio Co-processor (RCP).
  *
@@ -69,8 +91,10 @@ public:
     /**
      * This method initializes the HDLC interface.
      *
+     * @param[in]  aConfig  The uart connected to the RCP.
+     *
      */
-    void Init(void);
+    void Init(const HdlcUartConfig &aConfig);
 
     /**
      * This method deinitializes the HDLC interface.
@@ -79,17 +103,20 @@ public:
     void Deinit(void);
 
     /**
-     * This method encodes and sends a spinel frame to Radio Co-processor (RCP) over the socket.
+     * This method encodes a spinel frame and queues it for transmission to Radio Co-processor (RCP).
      *
-     * This is blocking call, i.e., if the socket is not writable, this method waits for it to become writable for
-     * up to `kMaxWaitTime` interval.
+     * The frame is encoded in chunks of `kTxChunkSize` bytes which are appended to the TX queue, and the head of the
+     * queue is written to the UART FIFO right away. The rest of the queue is flushed from `Process()` (or
+     * `WaitForFrame()`) as the UART drains its FIFO, so this method does not wait for the UART in the common case.
+     *
+     * Only if the TX queue is full, this method waits for the UART to become writable for up to `kMaxWaitTime`
+     * interval.
      *
      * @param[in] aFrame     A pointer to buffer containing the spinel frame to send.
      * @param[in] aLength    The length (number of bytes) in the frame.
      *
-     * @retval OT_ERROR_NONE     Successfully encoded and sent the spinel frame.
-     * @retval OT_ERROR_NO_BUFS  Insufficient buffer space available to encode the frame.
-     * @retval OT_ERROR_FAILED   Failed to send due to socket not becoming writable within `kMaxWaitTime`.
+     * @retval OT_ERROR_NONE     Successfully encoded and queued the spinel frame.
+     * @retval OT_ERROR_FAILED   Failed to queue due to UART not becoming writable within `kMaxWaitTime`.
      *
      */
     otError SendFrame(const uint8_t *aFrame, uint16_t aLength);
@@ -97,6 +124,8 @@ public:
     /**
      * This method waits for receiving part or all of spinel frame within specified timeout.
      *
+     * Queued frames are flushed to the UART while waiting.
+     *
      * @param[in]  aTimeoutUs  The timeout value in microseconds.
      *
      * @retval OT_ERROR_NONE             Part or all of spinel frame is received.
@@ -105,10 +134,85 @@ public:
      */
     otError WaitForFrame(uint64_t aTimeoutUs);
 
+    /**
+     * This method asks the RCP to move the UART link to a different baud rate.
+     *
+     * This method MUST be called before `RadioSpinel` is initialized, so that no spinel transaction of its own can be
+     * outstanding. The request is sent at the current baud rate. If the RCP accepts it, the local UART switches to
+     * @p aBaudRate once the response has been received. If the RCP does not answer, it may already run at
+     * @p aBaudRate (e.g. after a host reset), so it is probed at that rate before the link falls back to the current
+     * baud rate.
+     *
+     * A hardware reset brings the RCP back at its default baud rate. Unless the RCP rejected the request, the link is
+     * renegotiated from `Process()` once a response times out, framing errors are seen at the negotiated baud rate or
+     * an RCP reset is received at the default baud rate.
+     *
+     * @param[in]  aBaudRate  The requested baud rate.
+     *
+     * @retval OT_ERROR_NONE              The link now runs at @p aBaudRate.
+     * @retval OT_ERROR_NOT_IMPLEMENTED   The RCP does not support changing the baud rate.
+     * @retval OT_ERROR_RESPONSE_TIMEOUT  The RCP did not answer in time.
+     * @retval OT_ERROR_FAILED            The request could not be sent.
+     *
+     */
+    otError NegotiateBaudRate(uint32_t aBaudRate);
+
+    /**
+     * This method returns the number of partial frames dropped by the HDLC decoder.
+     *
+     * A frame is dropped when its FCS does not match, when it is malformed, or when the decoder is reset after received
+     * bytes have been lost.
+     *
+     */
+    uint32_t GetHdlcResyncs(void) const { return __atomic_load_n(&mHdlcResyncs, __ATOMIC_RELAXED); }
+
+    /**
+     * This method resets the number of partial frames dropped by the HDLC decoder.
+     *
+     */
+    void ResetHdlcResyncs(void) { __atomic_store_n(&mHdlcResyncs, 0, __ATOMIC_RELAXED); }
+
+    /**
+     * This method returns the link statistics.
+     *
+     * The counters are updated atomically by both the mainloop and the RX task, each of them is read as a whole.
+     *
+     */
+    const otSysRcpLinkStats &GetLinkStats(void) const { return mLinkStats; }
+
+    /**
+     * This method resets the link statistics.
+     *
+     */
+    void ResetLinkStats(void);
+
+    /**
+     * This method returns the number of RCP resets observed on the link.
+     *
+     * Host side copies of RCP state are stale once this value changes.
+     *
+     */
+    uint32_t GetRcpResetCount(void) const { return mRcpResetCount; }
+
+    /**
+     * This method returns the estimate of the RCP clock.
+     *
+     */
+    const RcpClock &GetRcpClock(void) const { return mRcpClock; }
+
+    /**
+     * This method indicates whether all queued bytes have been transmitted to the RCP.
+     *
+     */
+    bool IsIdle(void) const;
+
     /**
      * This method performs radio driver processing.
      *
-     * @param[in]  aContext  The context containing no thing, never used.
+     * The UART is read when its event has been signaled by the UART driver. With the radio RX task, the frames it has
+     * decoded are handled instead.
+     *
+     * @param[in]  aMainloop  The mainloop context.
      *
      */
     void Process(const otSysMainloopContext &aMainloop);
@@ -116,6 +220,9 @@ public:
     /**
      * This methods updates the mainloop context.
      *
+     * The radio UART is not polled through file descriptors, only the timeout is shortened so that the TX queue keeps
+     * being flushed.
+     *
      * @param[in] aMainloop  A mainloop context.
      *
      */
@@ -130,54 +237,219 @@ private:
          */
         kMaxFrameSize = ot::Spinel::SpinelInterface::kMaxFrameSize,
 
+        /**
+         * Size of the UART receive ring buffer, MUST be a power of two.
+         *
+         */
+        kRxBufferSize = kMaxFrameSize,
+
+        /**
+         * Size of the buffer holding one encoded chunk of a frame being sent.
+         *
+         */
+        kTxChunkSize = 128,
+
+        /**
+         * Size of the queue of encoded frames waiting for the UART, MUST be a power of two.
+         *
+         */
+        kTxBufferSize = 2048,
+
         /**
          * Maximum wait time in Milliseconds for socket to become writable (see `SendFrame`).
          *
          */
         kMaxWaitTime = 2000,
+
+        /**
+         * Maximum wait time in Milliseconds for the RCP to answer a baud rate change (see `NegotiateBaudRate`).
+         *
+         */
+        kBaudRateResponseTimeout = 500,
+
+        /**
+         * Spinel transaction id reserved for the baud rate change request and probe.
+         *
+         * `RadioSpinel` allocates its transaction ids from 1 upwards once initialized, so the highest one (15) is the
+         * least likely to be mistaken for one of its own if a response arrives after `NegotiateBaudRate` gave up.
+         *
+         */
+        kBaudRateTid = 15,
+
+        /**
+         * Number of bits sent on the UART per byte (8N1).
+         *
+         */
+        kUartBitsPerByte = 10,
+
+        /**
+         * Number of bytes the UART FIFO takes, the radio UART driver is installed without a TX ring buffer.
+         *
+         */
+        kTxFifoSize = UART_FIFO_LEN,
+    };
+
+    enum BaudRateState
+    {
+        kBaudRateIdle,
+        kBaudRatePending,
+        kBaudRateAccepted,
+        kBaudRateRejected,
     };
 
     void InitUart(void);
     void DeinitUart(void);
 
-    int TryReadAndDecode(void);
+    /**
+     * This method drains the UART driver into the receive ring buffer and decodes the received bytes in place.
+     *
+     * Reading continues until the UART driver has no more data, so back-to-back frames are handled in one pass.
+     *
+     * @returns The number of bytes read from the UART.
+     *
+     */
+    int  TryReadAndDecode(void);
+    void DecodeRxBuffer(void);
+
+    /**
+     * This method handles the errors reported by the UART driver.
+     *
+     * On a FIFO overflow, the pending input is flushed and the HDLC decoder resynchronizes on the next frame.
+     *
+     */
+    void HandleUartErrors(void);
 
     /**
-     * This method waits for the UART file descriptor associated with the HDLC interface to become writable within
-     * `kMaxWaitTime` interval.
+     * This method waits for the UART to transmit its FIFO within `kMaxWaitTime` interval and refills it from the TX
+     * queue.
      *
-     * @retval OT_ERROR_NONE   Socket is writable.
-     * @retval OT_ERROR_FAILED Socket did not become writable within `kMaxWaitTime`.
+     * @retval OT_ERROR_NONE   The UART FIFO has been transmitted.
+     * @retval OT_ERROR_FAILED The UART FIFO was not transmitted within `kMaxWaitTime`, e.g. the RCP holds CTS.
      *
      */
     otError WaitForWritable(void);
 
     /**
-     * This method writes a given frame to the socket.
+     * This method waits for the UART to transmit the whole TX queue, each FIFO within `kMaxWaitTime` interval.
+     *
+     * @retval OT_ERROR_NONE   The TX queue has been transmitted.
+     * @retval OT_ERROR_FAILED The UART FIFO was not transmitted within `kMaxWaitTime`.
+     *
+     */
+    otError WaitForTxDone(void);
+
+    /**
+     * This method appends encoded bytes to the TX queue.
      *
-     * This is blocking call, i.e., if the UART is not writable, this method waits for it to become writable for
-     * up to `kMaxWaitTime` interval.
+     * If the TX queue is full, this method waits for the UART to become writable for up to `kMaxWaitTime` interval
+     * and flushes the head of the queue.
      *
-     * @param[in] aFrame  A pointer to buffer containing the frame to write.
-     * @param[in] aLength The length (number of bytes) in the frame.
+     * @param[in] aFrame  A pointer to buffer containing the encoded bytes to queue.
+     * @param[in] aLength The length (number of bytes) of the encoded bytes.
      *
-     * @retval OT_ERROR_NONE    Frame was written successfully.
-     * @retval OT_ERROR_FAILED  Failed to write due to UART not becoming writable within `kMaxWaitTime`.
+     * @retval OT_ERROR_NONE    The bytes were queued successfully.
+     * @retval OT_ERROR_FAILED  Failed to queue due to UART not becoming writable within `kMaxWaitTime`.
      *
      */
     otError Write(const uint8_t *aFrame, uint16_t aLength);
 
+    /**
+     * This method writes the head of the TX queue to the free space of the UART FIFO.
+     *
+     * The rest stays queued, so this method does not block, even while the RCP holds CTS.
+     *
+     */
+    void FlushTxQueue(void);
+
+    /**
+     * This method returns the time in microseconds the UART takes to transmit @p aLength bytes.
+     *
+     */
+    uint64_t GetTxTime(uint32_t aLength) const;
+
     static void HandleHdlcFrame(void *aContext, otError aError);
     void        HandleHdlcFrame(otError aError);
 
+    /**
+     * This method handles a frame in the receive frame buffer and passes it to the frame callback.
+     *
+     * @param[in] aReceiveTime  The time the frame started to be received.
+     *
+     */
+    void HandleReceivedFrame(uint64_t aReceiveTime);
+
+#if OT_RADIO_RX_TASK_ENABLE
+    /**
+     * This method moves the decoded frame to the RX frame queue and wakes up the mainloop, it runs in the RX task.
+     *
+     * @param[in] aReceiveTime  The time the frame started to be received.
+     *
+     */
+    void QueueFrame(uint64_t aReceiveTime);
+
+    /**
+     * This method handles the frames in the RX frame queue.
+     *
+     * @retval TRUE   At least one frame has been handled.
+     * @retval FALSE  The RX frame queue was empty.
+     *
+     */
+    bool HandleQueuedFrames(void);
+
+    void        StartRxTask(void);
+    void        StopRxTask(void);
+    static void RxTask(void *aContext);
+    void        RxTask(void);
+#endif
+
+    otError     SendBaudRateRequest(uint8_t aCommand, uint32_t aKey, uint32_t aBaudRate);
+    otError     SetUartBaudRate(uint32_t aBaudRate);
+    void        RecoverBaudRate(void);
+    bool        HandleBaudRateResponse(const uint8_t *aFrame, uint16_t aLength);
+    static bool IsRcpResetFrame(const uint8_t *aFrame, uint16_t aLength);
+    static void AddToCounter(uint32_t &aCounter, uint32_t aValue);
+    static void ClearCounter(uint32_t &aCounter);
+    void        RecordLatency(void);
+
     ot::Spinel::SpinelInterface::ReceiveFrameCallback mReceiveFrameCallback;
     void *                                            mReceiveFrameContext;
     ot::Spinel::SpinelInterface::RxFrameBuffer &      mReceiveFrameBuffer;
 
-    ot::Hdlc::Decoder mHdlcDecoder;
-    uint8_t *         mUartRxBuffer;
+#if OT_RADIO_RX_TASK_ENABLE
+    // The RX task decodes into its own buffer, the frames are copied to the receive frame buffer by the mainloop.
+    ot::Spinel::SpinelInterface::RxFrameBuffer mRxTaskFrameBuffer;
+    FrameQueue                                 mRxFrameQueue;
+    uint8_t *                                  mRxFrameQueueBuffer;
+    SemaphoreHandle_t                          mRxFrameSemaphore;
+    TaskHandle_t volatile                      mRxTask;
+    volatile bool                              mRxTaskStop;
+#endif
+
+    // The buffer the HDLC decoder writes to.
+    ot::Spinel::SpinelInterface::RxFrameBuffer &mDecodeFrameBuffer;
+
+    HdlcDecoder mHdlcDecoder;
+    uint8_t *   mUartRxBuffer;
+    RingBuffer  mRxRingBuffer;
+    uint8_t *   mUartTxBuffer;
+    RingBuffer  mTxRingBuffer;
+
+    uint32_t mHdlcResyncs;
+    uint32_t mRcpResetCount;
+    RcpClock mRcpClock;
+
+    otSysRcpLinkStats mLinkStats;
+    uint64_t          mLastTxFrameTime;
+    bool              mResponsePending;
+    bool              mWaitingForFrame;
 
-    int mUartFd;
+    HdlcUartConfig mConfig;
+    BaudRateState  mBaudRateState;
+    uint32_t       mBaudRateKey;
+    uint32_t       mBaudRateTarget;
+    uint32_t       mBaudRate;
+    uint32_t       mNegotiatedBaudRate;
+    volatile bool  mBaudRateRecoveryPending;
 
     // Non-copyable, intentionally not implemented.
     HdlcInterface(const HdlcInterface &);
@@ -0,0 +1,381 @@
+/*
+ *  Copyright (c) 2020, The OpenThread Authors.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  3. Neither the name of the copyright holder nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "spinel_spi.hpp"
+
+#include <string.h>
+
+#include <driver/gpio.h>
+#include <esp_attr.h>
+#include <esp_heap_caps.h>
+#include <esp_log.h>
+
+#include <openthread/platform/time.h>
+
+#include "error_handling.h"
+
+namespace ot {
+
+namespace Esp32 {
+
+SpiInterface::SpiInterface(ot::Spinel::SpinelInterface::ReceiveFrameCallback aCallback,
+                           void *                                            aCallbackContext,
+                           ot::Spinel::SpinelInterface::RxFrameBuffer &      aFrameBuffer)
+    : mReceiveFrameCallback(aCallback)
+    , mReceiveFrameContext(aCallbackContext)
+    , mReceiveFrameBuffer(aFrameBuffer)
+    , mDevice(NULL)
+    , mInterruptSemaphore(NULL)
+    , mEventSemaphore(NULL)
+    , mTxBuffer(NULL)
+    , mRxBuffer(NULL)
+    , mFrameLink(OT_RADIO_SPI_ALIGN_ALLOWANCE, OT_RADIO_SPI_SMALL_PACKET_SIZE, kMaxFrameSize)
+    , mFrameReceived(false)
+    , mRcpResetCount(0)
+    , mLinkStats()
+    , mLastTxFrameTime(0)
+    , mResponsePending(false)
+{
+}
+
+SpiInterface::~SpiInterface(void)
+{
+}
+
+void SpiInterface::Init(void)
+{
+    esp_err_t        error;
+    spi_bus_config_t busConfig = {.mosi_io_num     = OT_RADIO_SPI_MOSI,
+                                  .miso_io_num     = OT_RADIO_SPI_MISO,
+                                  .sclk_io_num     = OT_RADIO_SPI_SCLK,
+                                  .quadwp_io_num   = -1,
+                                  .quadhd_io_num   = -1,
+                                  .max_transfer_sz = kBufferSize,
+                                  .flags           = 0,
+                                  .intr_flags      = 0};
+    spi_device_interface_config_t deviceConfig = {.command_bits     = 0,
+                                                  .address_bits     = 0,
+                                                  .dummy_bits       = 0,
+                                                  .mode             = OT_RADIO_SPI_MODE,
+                                                  .duty_cycle_pos   = 0,
+                                                  .cs_ena_pretrans  = 0,
+                                                  .cs_ena_posttrans = 0,
+                                                  .clock_speed_hz   = OT_RADIO_SPI_CLOCK_HZ,
+                                                  .input_delay_ns   = 0,
+                                                  .spics_io_num     = OT_RADIO_SPI_CS,
+                                                  .flags            = 0,
+                                                  .queue_size       = 1,
+                                                  .pre_cb           = NULL,
+                                                  .post_cb          = NULL};
+    gpio_config_t interruptConfig = {.pin_bit_mask = 1ULL << OT_RADIO_SPI_INT,
+                                     .mode         = GPIO_MODE_INPUT,
+                                     .pull_up_en   = GPIO_PULLUP_ENABLE,
+                                     .pull_down_en = GPIO_PULLDOWN_DISABLE,
+                                     .intr_type    = GPIO_INTR_NEGEDGE};
+
+    // Transfer buffers MUST be DMA capable.
+    mTxBuffer = static_cast<uint8_t *>(heap_caps_malloc(kBufferSize, MALLOC_CAP_DMA));
+    VerifyOrDie(mTxBuffer != NULL, OT_EXIT_FAILURE);
+    mRxBuffer = static_cast<uint8_t *>(heap_caps_malloc(kBufferSize, MALLOC_CAP_DMA));
+    VerifyOrDie(mRxBuffer != NULL, OT_EXIT_FAILURE);
+
+    ESP_ERROR_CHECK(spi_bus_initialize(OT_RADIO_SPI_HOST, &busConfig, /* dma_chan */ 1));
+    ESP_ERROR_CHECK(spi_bus_add_device(OT_RADIO_SPI_HOST, &deviceConfig, &mDevice));
+
+    mInterruptSemaphore = xSemaphoreCreateBinary();
+    VerifyOrDie(mInterruptSemaphore != NULL, OT_EXIT_FAILURE);
+    mEventSemaphore = xSemaphoreCreateBinary();
+    VerifyOrDie(mEventSemaphore != NULL, OT_EXIT_FAILURE);
+    platformInterruptEventAdd(mEventSemaphore, OT_EVENT_RADIO_SPI);
+
+    ESP_ERROR_CHECK(gpio_config(&interruptConfig));
+
+    // The ISR service may already have been installed by the application.
+    error = gpio_install_isr_service(0);
+    VerifyOrDie(error == ESP_OK || error == ESP_ERR_INVALID_STATE, OT_EXIT_FAILURE);
+    ESP_ERROR_CHECK(gpio_isr_handler_add(OT_RADIO_SPI_INT, HandleInterrupt, this));
+
+    mFrameLink.Reset();
+}
+
+void SpiInterface::Deinit(void)
+{
+    ESP_ERROR_CHECK(gpio_isr_handler_remove(OT_RADIO_SPI_INT));
+
+    platformInterruptEventRemove(mEventSemaphore);
+    vSemaphoreDelete(mEventSemaphore);
+    mEventSemaphore = NULL;
+    vSemaphoreDelete(mInterruptSemaphore);
+    mInterruptSemaphore = NULL;
+
+    ESP_ERROR_CHECK(spi_bus_remove_device(mDevice));
+    mDevice = NULL;
+    ESP_ERROR_CHECK(spi_bus_free(OT_RADIO_SPI_HOST));
+
+    heap_caps_free(mTxBuffer);
+    mTxBuffer = NULL;
+    heap_caps_free(mRxBuffer);
+    mRxBuffer = NULL;
+}
+
+void SpiInterface::ResetLinkStats(void)
+{
+    memset(&mLinkStats, 0, sizeof(mLinkStats));
+}
+
+otError SpiInterface::SendFrame(const uint8_t *aFrame, uint16_t aLength)
+{
+    otError  error = OT_ERROR_NONE;
+    uint64_t start = otPlatTimeGet();
+    uint64_t end   = start + kMaxWaitTime * OT_US_PER_MS;
+
+    VerifyOrExit(aLength <= kMaxFrameSize, error = OT_ERROR_NO_BUFS);
+
+    // The previous frame MUST be accepted by the RCP before the transfer buffer can be reused.
+    while (mFrameLink.IsTxPending())
+    {
+        VerifyOrExit(otPlatTimeGet() < end, error = OT_ERROR_FAILED);
+
+        EnableInterrupt();
+        PushPullSpi();
+
+        if (mFrameLink.IsTxPending())
+        {
+            xSemaphoreTake(mInterruptSemaphore, 1);
+        }
+    }
+
+    memcpy(mTxBuffer + SpiFrameLink::kHeaderSize, aFrame, aLength);
+    mFrameLink.QueueFrame(aLength);
+    mLinkStats.mTxFrames++;
+
+    PushPullSpi();
+
+exit:
+    mLinkStats.mWriteBlockedTime += otPlatTimeGet() - start;
+
+    if (error != OT_ERROR_NONE)
+    {
+        ESP_LOGE(OT_PLAT_LOG_TAG, "send radio frame failed");
+        mLinkStats.mWriteTimeouts++;
+    }
+
+    return error;
+}
+
+otError SpiInterface::WaitForFrame(uint64_t aTimeoutUs)
+{
+    otError  error = OT_ERROR_NONE;
+    uint64_t end   = otPlatTimeGet() + aTimeoutUs;
+
+    mFrameReceived = false;
+
+    while (true)
+    {
+        uint64_t   now = otPlatTimeGet();
+        TickType_t wait;
+
+        EnableInterrupt();
+
+        if (IsTransactionNeeded())
+        {
+            PushPullSpi();
+        }
+
+        VerifyOrExit(!mFrameReceived, OT_NOOP);
+        VerifyOrExit(now < end, error = OT_ERROR_RESPONSE_TIMEOUT);
+
+        if (!IsTransactionNeeded())
+        {
+            // Block until the RCP asserts its interrupt line.
+            wait = pdMS_TO_TICKS((end - now) / OT_US_PER_MS) + 1;
+        }
+        else if (!mFrameLink.IsRxPending() && !IsInterruptAsserted())
+        {
+            // Only the frame to send is pending, the RCP is not ready to accept it yet.
+            wait = 1;
+        }
+        else
+        {
+            wait = 0;
+        }
+
+        if (wait > 0)
+        {
+            xSemaphoreTake(mInterruptSemaphore, wait);
+        }
+    }
+
+exit:
+    if (mFrameReceived && mResponsePending)
+    {
+        uint64_t latency = (otPlatTimeGet() - mLastTxFrameTime) / OT_US_PER_MS;
+        uint8_t  bucket  = 0;
+
+        while (latency > 0 && bucket < OT_SYS_RCP_LATENCY_BUCKETS - 1)
+        {
+            latency >>= 1;
+            bucket++;
+        }
+
+        mLinkStats.mLatencyHistogram[bucket]++;
+        mResponsePending = false;
+    }
+
+    return error;
+}
+
+void SpiInterface::Process(const otSysMainloopContext &aMainloop)
+{
+    OT_UNUSED_VARIABLE(aMainloop);
+
+    for (uint8_t i = 0; i < kMaxTransactionsPerProcess && IsTransactionNeeded(); i++)
+    {
+        PushPullSpi();
+    }
+}
+
+void SpiInterface::Update(otSysMainloopContext &aMainloop)
+{
+    // The interrupt wakes up the mainloop poll.
+    EnableInterrupt();
+
+    VerifyOrExit(IsTransactionNeeded(), OT_NOOP);
+
+    if (mFrameLink.IsRxPending() || IsInterruptAsserted())
+    {
+        // The RCP has a frame to send.
+        aMainloop.mTimeout.tv_sec  = 0;
+        aMainloop.mTimeout.tv_usec = 0;
+    }
+    else if (aMainloop.mTimeout.tv_sec > 0 || aMainloop.mTimeout.tv_usec > OT_US_PER_MS)
+    {
+        // Retry the pending frame the RCP was not ready to accept.
+        aMainloop.mTimeout.tv_sec  = 0;
+        aMainloop.mTimeout.tv_usec = OT_US_PER_MS;
+    }
+
+exit:
+    return;
+}
+
+otError SpiInterface::PushPullSpi(void)
+{
+    otError              error;
+    spi_transaction_t    transaction;
+    SpiFrameLink::Result result;
+
+    memset(&transaction, 0, sizeof(transaction));
+    transaction.length    = mFrameLink.PrepareTransaction(mTxBuffer) * 8;
+    transaction.tx_buffer = mTxBuffer;
+    transaction.rx_buffer = mRxBuffer;
+    ESP_ERROR_CHECK(spi_device_polling_transmit(mDevice, &transaction));
+
+    error = mFrameLink.HandleTransaction(mRxBuffer, result);
+
+    if (result.mSlaveReset)
+    {
+        ESP_LOGI(OT_PLAT_LOG_TAG, "radio spi slave reset");
+        mRcpResetCount++;
+        mRcpClock.Reset();
+    }
+
+    if (result.mTxDone)
+    {
+        mLinkStats.mTxBytes += mFrameLink.GetTxLength();
+        mLastTxFrameTime = otPlatTimeGet();
+        mResponsePending = true;
+    }
+
+    if (result.mRxDropped)
+    {
+        mLinkStats.mDroppedFrames++;
+    }
+
+    if (result.mRxFrame != NULL)
+    {
+        HandleReceivedFrame(result.mRxFrame, result.mRxFrameLength);
+    }
+
+    return error;
+}
+
+void SpiInterface::EnableInterrupt(void)
+{
+    ESP_ERROR_CHECK(gpio_intr_enable(OT_RADIO_SPI_INT));
+}
+
+bool SpiInterface::IsInterruptAsserted(void) const
+{
+    return gpio_get_level(OT_RADIO_SPI_INT) == 0;
+}
+
+void SpiInterface::HandleReceivedFrame(const uint8_t *aFrame, uint16_t aLength)
+{
+    if (mReceiveFrameBuffer.CanWrite(aLength))
+    {
+        for (uint16_t i = 0; i < aLength; i++)
+        {
+            mReceiveFrameBuffer.WriteByte(aFrame[i]);
+        }
+
+        mLinkStats.mRxFrames++;
+        mLinkStats.mRxBytes += aLength;
+        mRcpClock.HandleReceivedFrame(aFrame, aLength, otPlatTimeGet());
+        mFrameReceived = true;
+        mReceiveFrameCallback(mReceiveFrameContext);
+    }
+    else
+    {
+        ESP_LOGE(OT_PLAT_LOG_TAG, "dropping radio frame: %s\n", otThreadErrorToString(OT_ERROR_NO_BUFS));
+        mLinkStats.mDroppedFrames++;
+        mReceiveFrameBuffer.DiscardFrame();
+    }
+}
+
+void IRAM_ATTR SpiInterface::HandleInterrupt(void *aContext)
+{
+    SpiInterface *spi   = static_cast<SpiInterface *>(aContext);
+    BaseType_t    woken = pdFALSE;
+
+    // The line is a low level interrupt while the chip may sleep, it only has to fire once. The interrupt type is left
+    // to the mainloop, it is unmasked again by EnableInterrupt().
+    gpio_intr_disable(OT_RADIO_SPI_INT);
+
+    xSemaphoreGiveFromISR(spi->mInterruptSemaphore, &woken);
+    xSemaphoreGiveFromISR(spi->mEventSemaphore, &woken);
+
+    if (woken == pdTRUE)
+    {
+        portYIELD_FROM_ISR();
+    }
+}
+
+} // namespace Esp32
+
+} // namespace ot
@@ -0,0 +1,259 @@
+/*
+ *  Copyright (c) 2020, The OpenThread Authors.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  3. Neither the name of the copyright holder nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef OT_ESP32_SPINEL_SPI_HPP_
+#define OT_ESP32_SPINEL_SPI_HPP_
+
+#include "openthread-core-esp32-config.h"
+
+#include <openthread/openthread-esp32.h>
+
+#include <driver/spi_master.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+
+#include "lib/spinel/spinel_interface.hpp"
+
+#include "platform-esp32.h"
+#include "rcp_clock.hpp"
+#include "spi_frame_link.hpp"
+
+namespace ot {
+
+namespace Esp32 {
+
+/**
+ * This class defines a spinel interface to the Radio Co-processor (RCP) over SPI.
+ *
+ * The host is the SPI master, the spinel SPI framing is implemented by `SpiFrameLink`. The RCP asserts an active low
+ * interrupt line while it has a frame to send.
+ *
+ */
+class SpiInterface
+{
+public:
+    /**
+     * This constructor initializes the object.
+     *
+     * @param[in] aCallback         Callback on frame received
+     * @param[in] aCallbackContext  Callback context
+     * @param[in] aFrameBuffer      A reference to a `RxFrameBuffer` object.
+     *
+     */
+    SpiInterface(ot::Spinel::SpinelInterface::ReceiveFrameCallback aCallback,
+                 void *                                            aCallbackContext,
+                 ot::Spinel::SpinelInterface::RxFrameBuffer &      aFrameBuffer);
+
+    /**
+     * This destructor deinitializes the object.
+     *
+     */
+    ~SpiInterface(void);
+
+    /**
+     * This method initializes the SPI interface.
+     *
+     */
+    void Init(void);
+
+    /**
+     * This method deinitializes the SPI interface.
+     *
+     */
+    void Deinit(void);
+
+    /**
+     * This method sends a spinel frame to Radio Co-processor (RCP).
+     *
+     * The frame is clocked out right away if the RCP accepts it, otherwise it stays pending and is retried from
+     * `Process()` (or `WaitForFrame()`). Only if a previous frame is still pending, this method waits for up to
+     * `kMaxWaitTime` interval for the RCP to accept it.
+     *
+     * @param[in] aFrame     A pointer to buffer containing the spinel frame to send.
+     * @param[in] aLength    The length (number of bytes) in the frame.
+     *
+     * @retval OT_ERROR_NONE     Successfully sent or queued the spinel frame.
+     * @retval OT_ERROR_NO_BUFS  The frame is larger than the maximum spinel frame size.
+     * @retval OT_ERROR_FAILED   The RCP did not accept the previous frame within `kMaxWaitTime`.
+     *
+     */
+    otError SendFrame(const uint8_t *aFrame, uint16_t aLength);
+
+    /**
+     * This method waits for receiving a spinel frame within specified timeout.
+     *
+     * @param[in]  aTimeoutUs  The timeout value in microseconds.
+     *
+     * @retval OT_ERROR_NONE             A spinel frame is received.
+     * @retval OT_ERROR_RESPONSE_TIMEOUT No spinel frame is received within @p aTimeoutUs.
+     *
+     */
+    otError WaitForFrame(uint64_t aTimeoutUs);
+
+    /**
+     * This method returns the link statistics.
+     *
+     */
+    const otSysRcpLinkStats &GetLinkStats(void) const { return mLinkStats; }
+
+    /**
+     * This method resets the link statistics.
+     *
+     */
+    void ResetLinkStats(void);
+
+    /**
+     * This method returns the number of RCP resets observed on the link.
+     *
+     * Host side copies of RCP state are stale once this value changes.
+     *
+     */
+    uint32_t GetRcpResetCount(void) const { return mRcpResetCount; }
+
+    /**
+     * This method returns the estimate of the RCP clock.
+     *
+     */
+    const RcpClock &GetRcpClock(void) const { return mRcpClock; }
+
+    /**
+     * This method indicates whether no frame is pending in either direction and the RCP does not assert its interrupt.
+     *
+     */
+    bool IsIdle(void) const { return !IsTransactionNeeded(); }
+
+    /**
+     * This method performs radio driver processing.
+     *
+     * SPI transactions are performed while the RCP asserts the interrupt line or a frame is pending.
+     *
+     * @param[in]  aMainloop  The mainloop context.
+     *
+     */
+    void Process(const otSysMainloopContext &aMainloop);
+
+    /**
+     * This methods updates the mainloop context.
+     *
+     * @param[in] aMainloop  A mainloop context.
+     *
+     */
+    void Update(otSysMainloopContext &aMainloop);
+
+private:
+    enum
+    {
+        /**
+         * Maximum spinel frame size.
+         *
+         */
+        kMaxFrameSize = ot::Spinel::SpinelInterface::kMaxFrameSize,
+
+        /**
+         * Size of the SPI transfer buffers.
+         *
+         */
+        kBufferSize = OT_RADIO_SPI_ALIGN_ALLOWANCE + SpiFrameLink::kHeaderSize + kMaxFrameSize,
+
+        /**
+         * Maximum wait time in Milliseconds for the RCP to accept a frame (see `SendFrame`).
+         *
+         */
+        kMaxWaitTime = 2000,
+
+        /**
+         * Maximum number of back to back transactions in one `Process()` pass.
+         *
+         */
+        kMaxTransactionsPerProcess = 4,
+    };
+
+    /**
+     * This method performs one SPI transaction, sending the pending frame and receiving a frame from the RCP.
+     *
+     * @retval OT_ERROR_NONE   The transaction completed.
+     * @retval OT_ERROR_PARSE  The RCP header was invalid, the RCP is probably not ready.
+     *
+     */
+    otError PushPullSpi(void);
+
+    /**
+     * This method indicates whether the RCP asserts its interrupt line.
+     *
+     */
+    bool IsInterruptAsserted(void) const;
+
+    /**
+     * This method unmasks the interrupt line, which the interrupt handler masks whenever it fires.
+     *
+     * The line is sampled by `IsTransactionNeeded()` after this method returns, so no assertion is missed.
+     *
+     */
+    void EnableInterrupt(void);
+
+    /**
+     * This method indicates whether a transaction is needed.
+     *
+     */
+    bool IsTransactionNeeded(void) const
+    {
+        return mFrameLink.IsTxPending() || mFrameLink.IsRxPending() || IsInterruptAsserted();
+    }
+
+    void HandleReceivedFrame(const uint8_t *aFrame, uint16_t aLength);
+
+    static void HandleInterrupt(void *aContext);
+
+    ot::Spinel::SpinelInterface::ReceiveFrameCallback mReceiveFrameCallback;
+    void *                                            mReceiveFrameContext;
+    ot::Spinel::SpinelInterface::RxFrameBuffer &      mReceiveFrameBuffer;
+
+    spi_device_handle_t mDevice;
+    SemaphoreHandle_t   mInterruptSemaphore;
+    SemaphoreHandle_t   mEventSemaphore;
+    uint8_t *           mTxBuffer;
+    uint8_t *           mRxBuffer;
+    SpiFrameLink        mFrameLink;
+    bool                mFrameReceived;
+    uint32_t            mRcpResetCount;
+    RcpClock            mRcpClock;
+
+    otSysRcpLinkStats mLinkStats;
+    uint64_t          mLastTxFrameTime;
+    bool              mResponsePending;
+
+    // Non-copyable, intentionally not implemented.
+    SpiInterface(const SpiInterface &);
+    SpiInterface &operator=(const SpiInterface &);
+};
+
+} // namespace Esp32
+
+} // namespace ot
+
+#endif // OT_ESP32_SPINEL_SPI_HPP_
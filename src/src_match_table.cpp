@@ -0,0 +1,343 @@
+/*
+ *  Copyright (c) 2020, The OpenThread Authors.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  3. Neither the name of the copyright holder nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "src_match_table.hpp"
+
+#include <assert.h>
+#include <string.h>
+
+#include "error_handling.h"
+
+namespace ot {
+
+namespace Esp32 {
+
+SrcMatchTable::SrcMatchTable(void)
+    : mClearShortEntries(false)
+    , mClearExtEntries(false)
+    , mHasPendingChanges(false)
+{
+    memset(mShortStates, kStateFree, sizeof(mShortStates));
+    memset(mExtStates, kStateFree, sizeof(mExtStates));
+}
+
+otError SrcMatchTable::AddShortEntry(uint16_t aShortAddress)
+{
+    otError error = OT_ERROR_NONE;
+    uint8_t free  = kShortEntryNum;
+
+    for (uint8_t i = 0; i < kShortEntryNum; i++)
+    {
+        if (mShortStates[i] == kStateFree)
+        {
+            free = (free == kShortEntryNum) ? i : free;
+        }
+        else if (mShortAddresses[i] == aShortAddress)
+        {
+            // Cancel a pending clear, the RCP still holds the entry.
+            if (mShortStates[i] == kStateClearing)
+            {
+                mShortStates[i] = kStateSynced;
+            }
+
+            ExitNow();
+        }
+    }
+
+    VerifyOrExit(free < kShortEntryNum, error = OT_ERROR_NO_BUFS);
+
+    mShortAddresses[free] = aShortAddress;
+    mShortStates[free]    = kStateAdding;
+    mHasPendingChanges    = true;
+
+exit:
+    return error;
+}
+
+otError SrcMatchTable::AddExtEntry(const otExtAddress &aExtAddress)
+{
+    otError error = OT_ERROR_NONE;
+    uint8_t free  = kExtEntryNum;
+
+    for (uint8_t i = 0; i < kExtEntryNum; i++)
+    {
+        if (mExtStates[i] == kStateFree)
+        {
+            free = (free == kExtEntryNum) ? i : free;
+        }
+        else if (memcmp(&mExtAddresses[i], &aExtAddress, sizeof(otExtAddress)) == 0)
+        {
+            // Cancel a pending clear, the RCP still holds the entry.
+            if (mExtStates[i] == kStateClearing)
+            {
+                mExtStates[i] = kStateSynced;
+            }
+
+            ExitNow();
+        }
+    }
+
+    VerifyOrExit(free < kExtEntryNum, error = OT_ERROR_NO_BUFS);
+
+    mExtAddresses[free] = aExtAddress;
+    mExtStates[free]    = kStateAdding;
+    mHasPendingChanges  = true;
+
+exit:
+    return error;
+}
+
+otError SrcMatchTable::ClearShortEntry(uint16_t aShortAddress)
+{
+    otError error = OT_ERROR_NO_ADDRESS;
+
+    for (uint8_t i = 0; i < kShortEntryNum; i++)
+    {
+        if (mShortStates[i] == kStateFree || mShortStates[i] == kStateClearing ||
+            mShortAddresses[i] != aShortAddress)
+        {
+            continue;
+        }
+
+        // An entry not yet added to the RCP is simply dropped.
+        mShortStates[i]    = (mShortStates[i] == kStateSynced) ? kStateClearing : kStateFree;
+        mHasPendingChanges = true;
+        error              = OT_ERROR_NONE;
+        break;
+    }
+
+    return error;
+}
+
+otError SrcMatchTable::ClearExtEntry(const otExtAddress &aExtAddress)
+{
+    otError error = OT_ERROR_NO_ADDRESS;
+
+    for (uint8_t i = 0; i < kExtEntryNum; i++)
+    {
+        if (mExtStates[i] == kStateFree || mExtStates[i] == kStateClearing ||
+            memcmp(&mExtAddresses[i], &aExtAddress, sizeof(otExtAddress)) != 0)
+        {
+            continue;
+        }
+
+        // An entry not yet added to the RCP is simply dropped.
+        mExtStates[i]      = (mExtStates[i] == kStateSynced) ? kStateClearing : kStateFree;
+        mHasPendingChanges = true;
+        error              = OT_ERROR_NONE;
+        break;
+    }
+
+    return error;
+}
+
+void SrcMatchTable::ClearShortEntries(void)
+{
+    ClearEntries(mShortStates, kShortEntryNum);
+    mClearShortEntries = true;
+    mHasPendingChanges = true;
+}
+
+void SrcMatchTable::ClearExtEntries(void)
+{
+    ClearEntries(mExtStates, kExtEntryNum);
+    mClearExtEntries   = true;
+    mHasPendingChanges = true;
+}
+
+void SrcMatchTable::Resync(void)
+{
+    ResyncEntries(mShortStates, kShortEntryNum);
+    ResyncEntries(mExtStates, kExtEntryNum);
+    mClearShortEntries = true;
+    mClearExtEntries   = true;
+    mHasPendingChanges = true;
+}
+
+bool SrcMatchTable::GetNextChange(Change &aChange)
+{
+    VerifyOrExit(mHasPendingChanges, OT_NOOP);
+
+    if (mClearShortEntries)
+    {
+        aChange.mOperation = Change::kClearShortEntries;
+        ExitNow();
+    }
+
+    if (mClearExtEntries)
+    {
+        aChange.mOperation = Change::kClearExtEntries;
+        ExitNow();
+    }
+
+    // Clear entries first, so that the RCP has room for the entries being added.
+    for (uint8_t state = kStateClearing; state >= kStateAdding; state--)
+    {
+        for (uint8_t i = 0; i < kShortEntryNum; i++)
+        {
+            if (mShortStates[i] == state)
+            {
+                aChange.mOperation    = (state == kStateClearing) ? Change::kClearShortEntry : Change::kAddShortEntry;
+                aChange.mIndex        = i;
+                aChange.mShortAddress = mShortAddresses[i];
+                ExitNow();
+            }
+        }
+
+        for (uint8_t i = 0; i < kExtEntryNum; i++)
+        {
+            if (mExtStates[i] == state)
+            {
+                aChange.mOperation  = (state == kStateClearing) ? Change::kClearExtEntry : Change::kAddExtEntry;
+                aChange.mIndex      = i;
+                aChange.mExtAddress = mExtAddresses[i];
+                ExitNow();
+            }
+        }
+    }
+
+    mHasPendingChanges = false;
+
+exit:
+    return mHasPendingChanges;
+}
+
+void SrcMatchTable::CommitChange(const Change &aChange)
+{
+    switch (aChange.mOperation)
+    {
+    case Change::kClearShortEntries:
+        mClearShortEntries = false;
+        break;
+
+    case Change::kClearExtEntries:
+        mClearExtEntries = false;
+        break;
+
+    case Change::kAddShortEntry:
+        mShortStates[aChange.mIndex] = kStateSynced;
+        ExitNow();
+
+    case Change::kAddExtEntry:
+        mExtStates[aChange.mIndex] = kStateSynced;
+        ExitNow();
+
+    case Change::kClearShortEntry:
+        mShortStates[aChange.mIndex] = kStateFree;
+        break;
+
+    case Change::kClearExtEntry:
+        mExtStates[aChange.mIndex] = kStateFree;
+        break;
+    }
+
+    // Room has been made on the RCP. Its tables may share their storage, so entries rejected from both are retried.
+    if (RetryEntries(mShortStates, kShortEntryNum) | RetryEntries(mExtStates, kExtEntryNum))
+    {
+        mHasPendingChanges = true;
+    }
+
+exit:
+    return;
+}
+
+void SrcMatchTable::RejectChange(const Change &aChange)
+{
+    switch (aChange.mOperation)
+    {
+    case Change::kAddShortEntry:
+        mShortStates[aChange.mIndex] = kStateRejected;
+        break;
+
+    case Change::kAddExtEntry:
+        mExtStates[aChange.mIndex] = kStateRejected;
+        break;
+
+    default:
+        assert(false);
+        break;
+    }
+}
+
+bool SrcMatchTable::IsOverflowed(void) const
+{
+    return HasEntries(mShortStates, kShortEntryNum, kStateRejected) ||
+           HasEntries(mExtStates, kExtEntryNum, kStateRejected);
+}
+
+void SrcMatchTable::ClearEntries(uint8_t *aStates, uint8_t aNum)
+{
+    memset(aStates, kStateFree, aNum);
+}
+
+void SrcMatchTable::ResyncEntries(uint8_t *aStates, uint8_t aNum)
+{
+    for (uint8_t i = 0; i < aNum; i++)
+    {
+        if (aStates[i] == kStateSynced || aStates[i] == kStateRejected)
+        {
+            aStates[i] = kStateAdding;
+        }
+        else if (aStates[i] == kStateClearing)
+        {
+            aStates[i] = kStateFree;
+        }
+    }
+}
+
+bool SrcMatchTable::RetryEntries(uint8_t *aStates, uint8_t aNum)
+{
+    bool retry = false;
+
+    for (uint8_t i = 0; i < aNum; i++)
+    {
+        if (aStates[i] == kStateRejected)
+        {
+            aStates[i] = kStateAdding;
+            retry      = true;
+        }
+    }
+
+    return retry;
+}
+
+bool SrcMatchTable::HasEntries(const uint8_t *aStates, uint8_t aNum, State aState)
+{
+    bool found = false;
+
+    for (uint8_t i = 0; i < aNum && !found; i++)
+    {
+        found = (aStates[i] == aState);
+    }
+
+    return found;
+}
+
+} // namespace Esp32
+
+} // namespace ot
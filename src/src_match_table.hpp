@@ -0,0 +1,221 @@
+/*
+ *  Copyright (c) 2020, The OpenThread Authors.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  3. Neither the name of the copyright holder nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef OT_ESP32_SRC_MATCH_TABLE_HPP_
+#define OT_ESP32_SRC_MATCH_TABLE_HPP_
+
+#include <stdint.h>
+
+#include <openthread/error.h>
+#include <openthread/platform/radio.h>
+
+#include "platform-esp32.h"
+
+namespace ot {
+
+namespace Esp32 {
+
+/**
+ * This class implements a host side shadow of the RCP source match table.
+ *
+ * Entries are added and cleared locally, and the differences to the table held by the RCP are collected as pending
+ * changes. Changes cancelling each other (e.g. adding and clearing the same entry) never reach the RCP. Entries the
+ * RCP has no room for are kept and added again once an entry has been cleared on the RCP. Extended addresses are
+ * stored in the byte order used on the spinel link.
+ *
+ */
+class SrcMatchTable
+{
+public:
+    /**
+     * This structure represents a change to apply to the RCP source match table.
+     *
+     */
+    struct Change
+    {
+        enum Operation
+        {
+            kClearShortEntries, ///< Clear all short address entries.
+            kClearExtEntries,   ///< Clear all extended address entries.
+            kAddShortEntry,     ///< Add `mShortAddress`.
+            kAddExtEntry,       ///< Add `mExtAddress`.
+            kClearShortEntry,   ///< Clear `mShortAddress`.
+            kClearExtEntry,     ///< Clear `mExtAddress`.
+        };
+
+        Operation    mOperation;
+        uint8_t      mIndex;
+        uint16_t     mShortAddress;
+        otExtAddress mExtAddress;
+    };
+
+    /**
+     * This constructor initializes an empty table, in sync with an empty RCP table.
+     *
+     */
+    SrcMatchTable(void);
+
+    /**
+     * This method adds a short address entry.
+     *
+     * @retval OT_ERROR_NONE     The entry has been added, or was already present.
+     * @retval OT_ERROR_NO_BUFS  The table is full.
+     *
+     */
+    otError AddShortEntry(uint16_t aShortAddress);
+
+    /**
+     * This method adds an extended address entry.
+     *
+     * @param[in] aExtAddress  The extended address, in spinel byte order.
+     *
+     * @retval OT_ERROR_NONE     The entry has been added, or was already present.
+     * @retval OT_ERROR_NO_BUFS  The table is full.
+     *
+     */
+    otError AddExtEntry(const otExtAddress &aExtAddress);
+
+    /**
+     * This method clears a short address entry.
+     *
+     * @retval OT_ERROR_NONE        The entry has been cleared.
+     * @retval OT_ERROR_NO_ADDRESS  The entry was not in the table.
+     *
+     */
+    otError ClearShortEntry(uint16_t aShortAddress);
+
+    /**
+     * This method clears an extended address entry.
+     *
+     * @param[in] aExtAddress  The extended address, in spinel byte order.
+     *
+     * @retval OT_ERROR_NONE        The entry has been cleared.
+     * @retval OT_ERROR_NO_ADDRESS  The entry was not in the table.
+     *
+     */
+    otError ClearExtEntry(const otExtAddress &aExtAddress);
+
+    /**
+     * This method clears all short address entries.
+     *
+     */
+    void ClearShortEntries(void);
+
+    /**
+     * This method clears all extended address entries.
+     *
+     */
+    void ClearExtEntries(void);
+
+    /**
+     * This method marks the whole table to be written again, after the RCP has lost its copy.
+     *
+     */
+    void Resync(void);
+
+    /**
+     * This method indicates whether there are changes to apply to the RCP.
+     *
+     */
+    bool HasPendingChanges(void) const { return mHasPendingChanges; }
+
+    /**
+     * This method gets the next change to apply to the RCP.
+     *
+     * Clearing all entries always comes before adding entries. The change MUST be committed with `CommitChange()`
+     * before the next one is retrieved.
+     *
+     * @param[out] aChange  A reference to the change.
+     *
+     * @retval TRUE   @p aChange holds the next change.
+     * @retval FALSE  The RCP table is in sync.
+     *
+     */
+    bool GetNextChange(Change &aChange);
+
+    /**
+     * This method marks a change as applied to the RCP.
+     *
+     * Entries rejected by the RCP are retried after an entry has been cleared on the RCP.
+     *
+     * @param[in] aChange  The change returned by `GetNextChange()`.
+     *
+     */
+    void CommitChange(const Change &aChange);
+
+    /**
+     * This method marks an add change as rejected by the RCP because its table is full.
+     *
+     * The entry is not offered by `GetNextChange()` again until an entry has been cleared on the RCP.
+     *
+     * @param[in] aChange  The add change returned by `GetNextChange()`.
+     *
+     */
+    void RejectChange(const Change &aChange);
+
+    /**
+     * This method indicates whether some entries could not be added to the RCP because its table is full.
+     *
+     */
+    bool IsOverflowed(void) const;
+
+private:
+    enum
+    {
+        kShortEntryNum = OT_RADIO_SRC_MATCH_SHORT_ENTRY_NUM,
+        kExtEntryNum   = OT_RADIO_SRC_MATCH_EXT_ENTRY_NUM,
+    };
+
+    enum State
+    {
+        kStateFree,     ///< The entry is not used, neither locally nor on the RCP.
+        kStateSynced,   ///< The entry is used and present on the RCP.
+        kStateAdding,   ///< The entry is used but not yet added to the RCP.
+        kStateClearing, ///< The entry is not used but still present on the RCP.
+        kStateRejected, ///< The entry is used but the RCP had no room for it.
+    };
+
+    static void ClearEntries(uint8_t *aStates, uint8_t aNum);
+    static void ResyncEntries(uint8_t *aStates, uint8_t aNum);
+    static bool RetryEntries(uint8_t *aStates, uint8_t aNum);
+    static bool HasEntries(const uint8_t *aStates, uint8_t aNum, State aState);
+
+    uint16_t     mShortAddresses[kShortEntryNum];
+    uint8_t      mShortStates[kShortEntryNum];
+    otExtAddress mExtAddresses[kExtEntryNum];
+    uint8_t      mExtStates[kExtEntryNum];
+    bool         mClearShortEntries;
+    bool         mClearExtEntries;
+    bool         mHasPendingChanges;
+};
+
+} // namespace Esp32
+
+} // namespace ot
+
+#endif // OT_ESP32_SRC_MATCH_TABLE_HPP_
@@ -28,22 +28,62 @@
 
 #include "platform-esp32.h"
 
+#include <string.h>
 #include <sys/select.h>
 #include <unistd.h>
 
 #include <esp_log.h>
+#include <esp_timer.h>
 
 #include <freertos/FreeRTOS.h>
 #include <freertos/queue.h>
+#include <freertos/task.h>
 
+#include <openthread/instance.h>
 #include <openthread/tasklet.h>
 #include <openthread/platform/alarm-milli.h>
 #include <openthread/platform/time.h>
 
 #include <openthread/openthread-esp32.h>
 
+#include "error_handling.h"
+
 extern bool gPlatformPseudoResetWasRequested;
 
+static otSysMainloopStats sMainloopStats;
+static uint64_t           sIntervalStart;
+static uint64_t           sPhaseStart;
+static TaskHandle_t       sMainloopTask;
+static bool               sApiLockPhase; // Whether the mainloop task is about to wait for the API lock.
+
+static uint64_t getTime(void)
+{
+    // The cpu cycle counter is not used, its rate changes with the cpu frequency.
+    return (uint64_t)esp_timer_get_time();
+}
+
+static void recordTime(otSysMainloopTime *aTime, uint64_t aStart, uint64_t aEnd)
+{
+    uint32_t time = (uint32_t)(aEnd - aStart);
+
+    aTime->mTotalTime += time;
+    aTime->mRuns++;
+
+    if (time > aTime->mMaxTime)
+    {
+        aTime->mMaxTime = time;
+    }
+}
+
+static uint64_t recordSourceTime(otSysMainloopSource aSource, uint64_t aStart)
+{
+    uint64_t now = getTime();
+
+    recordTime(&sMainloopStats.mSources[aSource], aStart, now);
+
+    return now;
+}
+
 void otSysInit(int argc, char *argv[])
 {
     OT_UNUSED_VARIABLE(argc);
@@ -55,21 +95,72 @@ void otSysInit(int argc, char *argv[])
     }
 
     platformVfsEventInit();
+    platformUartEventInit();
     platformApiLockInit();
+    platformApiCallInit();
+    platformAlarmInit();
     platformCliUartInit();
     platformRadioInit(/* aResetRadio */ true, /* aRestoreDataSetFromNcp */ false);
+    platformPowerInit();
+    otSysResetMainloopStats();
 
     ESP_LOGI(OT_PLAT_LOG_TAG, "init radio done");
 }
 
 void otSysDeinit(void)
 {
+    platformPowerDeinit();
     platformRadioDeinit();
     platformCliUartDeinit();
+    platformAlarmDeinit();
+    platformUartEventDeinit();
+    platformApiCallDeinit();
     platformApiLockDeinit();
     platformVfsEventDeinit();
 }
 
+otInstance *otSysInstanceInit(void *aInstanceBuffer, size_t *aInstanceBufferSize)
+{
+    // OpenThread constructs the instance in place, the instance pointer is the buffer.
+    otInstance *instance = (otInstance *)aInstanceBuffer;
+    otError     error    = OT_ERROR_NONE;
+
+    VerifyOrExit(aInstanceBuffer != NULL, instance = otInstanceInit(NULL, aInstanceBufferSize));
+
+    // The radio and the alarm are assigned first, OpenThread already uses them while the instance is initialized.
+    SuccessOrExit(error = platformRadioAddInstance(instance));
+    SuccessOrExit(error = platformAlarmAddInstance(instance));
+    VerifyOrExit(otInstanceInit(aInstanceBuffer, aInstanceBufferSize) != NULL, error = OT_ERROR_NO_BUFS);
+
+exit:
+    if (error != OT_ERROR_NONE)
+    {
+        ESP_LOGE(OT_PLAT_LOG_TAG, "failed to initialize the instance: %s", otThreadErrorToString(error));
+        platformAlarmRemoveInstance(instance);
+        platformRadioRemoveInstance(instance);
+        instance = NULL;
+    }
+
+    return instance;
+}
+
+void otSysInstanceFinalize(otInstance *aInstance)
+{
+    otInstanceFinalize(aInstance);
+    platformAlarmRemoveInstance(aInstance);
+    platformRadioRemoveInstance(aInstance);
+}
+
+#if OT_RADIO_NUM > 1
+void otTaskletsSignalPending(otInstance *aInstance)
+{
+    OT_UNUSED_VARIABLE(aInstance);
+
+    // The mainloop only checks the tasklets of the instance it is updated with, wake it up for the others.
+    platformVfsEventActivate();
+}
+#endif
+
 bool otSysPseudoResetWasRequested(void)
 {
     return gPlatformPseudoResetWasRequested;
@@ -77,44 +168,124 @@ bool otSysPseudoResetWasRequested(void)
 
 void otSysMainloopInit(otSysMainloopContext *aMainloop)
 {
+#if !OT_MAINLOOP_EVENT_GROUP_ENABLE
     FD_ZERO(&aMainloop->mReadFdSet);
     FD_ZERO(&aMainloop->mWriteFdSet);
     FD_ZERO(&aMainloop->mErrorFdSet);
+#endif
 
     aMainloop->mMaxFd           = -1;
     aMainloop->mTimeout.tv_sec  = 10;
     aMainloop->mTimeout.tv_usec = 0;
+
+    sMainloopStats.mIterations++;
+    sMainloopTask = xTaskGetCurrentTaskHandle();
+    sApiLockPhase = true;
+    sPhaseStart   = getTime();
 }
 
 void otSysMainloopUpdate(otInstance *aInstance, otSysMainloopContext *aMainloop)
 {
+    uint64_t start = getTime();
+    uint64_t now;
+
+    sApiLockPhase = false;
+    recordTime(&sMainloopStats.mPhases[OT_SYS_MAINLOOP_PHASE_TASKLETS], sPhaseStart, start);
+
     platformVfsEventUpdate(aMainloop);
-    platformAlarmUpdate(aMainloop);
+    now = recordSourceTime(OT_SYS_MAINLOOP_SOURCE_VFS_EVENT, start);
     platformCliUartUpdate(aMainloop);
+    now = recordSourceTime(OT_SYS_MAINLOOP_SOURCE_CLI_UART, now);
     platformRadioUpdate(aMainloop);
+    now = recordSourceTime(OT_SYS_MAINLOOP_SOURCE_RADIO, now);
+    platformMainloopHandlerUpdate(aMainloop);
+    now = recordSourceTime(OT_SYS_MAINLOOP_SOURCE_HANDLERS, now);
 
     if (otTaskletsArePending(aInstance))
     {
         aMainloop->mTimeout.tv_sec  = 0;
         aMainloop->mTimeout.tv_usec = 0;
     }
+
+    now = getTime();
+    recordTime(&sMainloopStats.mPhases[OT_SYS_MAINLOOP_PHASE_UPDATE], start, now);
+    sPhaseStart = now;
 }
 
 int otSysMainloopPoll(otSysMainloopContext *aMainloop)
 {
-    return select(aMainloop->mMaxFd + 1, &aMainloop->mReadFdSet, &aMainloop->mWriteFdSet, &aMainloop->mErrorFdSet,
+    uint64_t start = getTime();
+    int      rval;
+
+    platformPowerPollBegin();
+#if OT_MAINLOOP_EVENT_GROUP_ENABLE
+    rval = platformVfsEventWait(aMainloop);
+#else
+    rval = select(aMainloop->mMaxFd + 1, &aMainloop->mReadFdSet, &aMainloop->mWriteFdSet, &aMainloop->mErrorFdSet,
                   &aMainloop->mTimeout);
+#endif
+    platformPowerPollEnd();
+
+    sApiLockPhase = true;
+    sPhaseStart   = getTime();
+    recordTime(&sMainloopStats.mPhases[OT_SYS_MAINLOOP_PHASE_POLL], start, sPhaseStart);
+
+    return rval;
 }
 
 void otSysMainloopProcess(otInstance *aInstance, const otSysMainloopContext *aMainloop)
 {
+    uint64_t start = getTime();
+    uint64_t now;
+
+    sApiLockPhase = false;
     platformVfsEventProcess(aInstance, aMainloop);
+    now = recordSourceTime(OT_SYS_MAINLOOP_SOURCE_VFS_EVENT, start);
     platformCliUartProcess(aInstance, aMainloop);
+    now = recordSourceTime(OT_SYS_MAINLOOP_SOURCE_CLI_UART, now);
     platformRadioProcess(aInstance, aMainloop);
+    now = recordSourceTime(OT_SYS_MAINLOOP_SOURCE_RADIO, now);
     platformAlarmProcess(aInstance, aMainloop);
+    now = recordSourceTime(OT_SYS_MAINLOOP_SOURCE_ALARM, now);
+    platformApiCallProcess(aInstance);
+    now = recordSourceTime(OT_SYS_MAINLOOP_SOURCE_API_CALLS, now);
+    platformMainloopHandlerProcess(aMainloop);
+    now = recordSourceTime(OT_SYS_MAINLOOP_SOURCE_HANDLERS, now);
+
+    recordTime(&sMainloopStats.mPhases[OT_SYS_MAINLOOP_PHASE_PROCESS], start, now);
+    sPhaseStart = now;
+}
+
+void platformMainloopApiLockTaken(void)
+{
+    uint64_t now;
+
+    // Other tasks take the lock at any time, only the mainloop task waiting between its phases is recorded.
+    VerifyOrExit(sApiLockPhase && xTaskGetCurrentTaskHandle() == sMainloopTask, OT_NOOP);
+
+    now = getTime();
+    recordTime(&sMainloopStats.mPhases[OT_SYS_MAINLOOP_PHASE_API_LOCK], sPhaseStart, now);
+    sApiLockPhase = false;
+    sPhaseStart   = now;
+
+exit:
+    return;
 }
 
 void otSysMainloopBreak(void)
 {
     platformVfsEventActivate();
 }
+
+void otSysGetMainloopStats(otSysMainloopStats *aStats)
+{
+    sMainloopStats.mIntervalTime = getTime() - sIntervalStart;
+    *aStats                      = sMainloopStats;
+}
+
+void otSysResetMainloopStats(void)
+{
+    memset(&sMainloopStats, 0, sizeof(sMainloopStats));
+    sIntervalStart = getTime();
+    sPhaseStart    = sIntervalStart;
+}
@@ -30,6 +30,7 @@
 
 #include <errno.h>
 #include <fcntl.h>
+#include <string.h>
 #include <sys/select.h>
 
 #include <openthread/platform/uart.h>
@@ -42,7 +43,77 @@
 
 #include "error_handling.h"
 
-static int sCliUartFd;
+static int      sCliUartFd;
+static uint32_t sCliLineLength;  // Number of characters the CLI holds of the line being received.
+static bool     sCliDiscardLine; // Whether the input is dropped up to the next line terminator.
+
+static bool isLineTerminator(uint8_t aChar)
+{
+    return aChar == '\r' || aChar == '\n';
+}
+
+static void discardCliLine(void)
+{
+    uint8_t erase[16];
+
+    memset(erase, '\b', sizeof(erase));
+
+    // The CLI keeps the start of the line, it is erased the way a user would, which also clears it on the terminal.
+    while (sCliLineLength > 0)
+    {
+        uint16_t length = sCliLineLength < sizeof(erase) ? (uint16_t)sCliLineLength : (uint16_t)sizeof(erase);
+
+        otPlatUartReceived(erase, length);
+        sCliLineLength -= length;
+    }
+
+    sCliDiscardLine = true;
+}
+
+static void receiveCliInput(const uint8_t *aBuf, uint16_t aLength)
+{
+    uint16_t start = 0;
+
+    if (sCliDiscardLine)
+    {
+        // The rest of the broken line is dropped together with its terminator.
+        while (start < aLength && !isLineTerminator(aBuf[start]))
+        {
+            start++;
+        }
+
+        VerifyOrExit(start < aLength, OT_NOOP);
+        start++;
+        sCliDiscardLine = false;
+    }
+
+    for (uint16_t i = start; i < aLength; i++)
+    {
+        if (isLineTerminator(aBuf[i]))
+        {
+            sCliLineLength = 0;
+        }
+        else if (aBuf[i] == '\b' || aBuf[i] == 127)
+        {
+            if (sCliLineLength > 0)
+            {
+                sCliLineLength--;
+            }
+        }
+        else
+        {
+            sCliLineLength++;
+        }
+    }
+
+    if (start < aLength)
+    {
+        otPlatUartReceived(aBuf + start, aLength - start);
+    }
+
+exit:
+    return;
+}
 
 otError otPlatUartEnable(void)
 {
@@ -76,13 +147,14 @@ exit:
 void platformCliUartInit()
 {
     char          uartPath[16];
-    uart_config_t uart_config = {.baud_rate           = 115200,
+    QueueHandle_t eventQueue;
+    uart_config_t uart_config = {.baud_rate           = OT_CLI_UART_BAUD_RATE,
                                  .data_bits           = UART_DATA_8_BITS,
                                  .parity              = UART_PARITY_DISABLE,
                                  .stop_bits           = UART_STOP_BITS_1,
                                  .flow_ctrl           = UART_HW_FLOWCTRL_DISABLE,
                                  .rx_flow_ctrl_thresh = 0,
-                                 .use_ref_tick        = false};
+                                 .use_ref_tick        = OT_CLI_UART_USE_REF_TICK};
     ESP_ERROR_CHECK(uart_param_config(OT_CLI_UART_NUM, &uart_config));
 
     // Disable IO buffer.
@@ -90,7 +162,9 @@ void platformCliUartInit()
     setvbuf(stdout, NULL, _IONBF, 0);
 
     // Install UART driver for interrupt-driven reads and writes.
-    ESP_ERROR_CHECK(uart_driver_install(OT_CLI_UART_NUM, OT_UART_RX_BUF_SIZE, 0, 0, NULL, 0));
+    ESP_ERROR_CHECK(
+        uart_driver_install(OT_CLI_UART_NUM, OT_CLI_UART_RX_BUF_SIZE, 0, OT_UART_EVENT_QUEUE_SIZE, &eventQueue, 0));
+    platformUartEventAdd(OT_CLI_UART_NUM, eventQueue, OT_EVENT_CLI_UART);
 
     // Tell VFS to use UART driver.
     esp_vfs_dev_uart_use_driver(OT_CLI_UART_NUM);
@@ -111,35 +185,60 @@ void platformCliUartDeinit(void)
         close(sCliUartFd);
         sCliUartFd = -1;
     }
+    platformUartEventRemove(OT_CLI_UART_NUM);
     uart_driver_delete(OT_CLI_UART_NUM);
 }
 
 void platformCliUartUpdate(otSysMainloopContext *aMainloop)
 {
-    FD_SET(sCliUartFd, &aMainloop->mReadFdSet);
-    if (sCliUartFd > aMainloop->mMaxFd)
-    {
-        aMainloop->mMaxFd = sCliUartFd;
-    }
+    // Received data is signaled through the event file.
+    (void)aMainloop;
 }
 
 void platformCliUartProcess(otInstance *aInstance, const otSysMainloopContext *aMainloop)
 {
+    uint8_t buffer[256];
+    int     rval;
+
     (void)aInstance;
+    (void)aMainloop;
 
-    if (FD_ISSET(sCliUartFd, &aMainloop->mReadFdSet))
+    VerifyOrExit(platformVfsEventIsSignaled(OT_EVENT_CLI_UART), OT_NOOP);
+
+    if (platformUartEventTakeErrors(OT_CLI_UART_NUM) & OT_UART_ERROR_FIFO_OVF)
     {
-        uint8_t buffer[256];
+        // Part of the input has been lost, the broken line must not be run as a command.
+        ESP_LOGW(OT_PLAT_LOG_TAG, "cli uart fifo overflow");
+        uart_flush_input(OT_CLI_UART_NUM);
+        discardCliLine();
+    }
+
+    platformUartEventSampleRxLevel(OT_CLI_UART_NUM);
 
-        int rval = read(sCliUartFd, buffer, sizeof(buffer));
+    // Drain all the received bytes until the driver would block.
+    do
+    {
+        rval = read(sCliUartFd, buffer, sizeof(buffer));
 
         if (rval > 0)
         {
-            otPlatUartReceived(buffer, (uint16_t)rval);
+            receiveCliInput(buffer, (uint16_t)rval);
         }
-        else if (rval > 0)
+        else if (rval < 0)
         {
             VerifyOrDie(errno == EAGAIN || errno == EINTR, OT_EXIT_FAILURE);
         }
-    }
+    } while (rval > 0);
+
+exit:
+    return;
+}
+
+void otSysGetCliUartStats(otInstance *aInstance, otSysUartStats *aStats)
+{
+    (void)aInstance;
+
+    platformUartEventGetStats(OT_CLI_UART_NUM, aStats);
+    aStats->mHdlcResyncs  = 0;
+    aStats->mRxBufferSize = OT_CLI_UART_RX_BUF_SIZE;
 }
@@ -0,0 +1,293 @@
+/*
+ *  Copyright (c) 2020, The OpenThread Authors.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  3. Neither the name of the copyright holder nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file forwards UART driver events to the OpenThread mainloop.
+ *
+ */
+
+#include "platform-esp32.h"
+
+#include <driver/uart.h>
+#include <esp_log.h>
+
+#include <freertos/FreeRTOS.h>
+#include <freertos/queue.h>
+#include <freertos/semphr.h>
+#include <freertos/task.h>
+
+#include "error_handling.h"
+
+typedef struct UartEventSource
+{
+    QueueHandle_t mQueue;
+    TaskHandle_t  mTask;
+    uint32_t      mEvent;
+    uint32_t      mErrors;
+    uint32_t      mFifoOverflows;
+    uint32_t      mBufferFullEvents;
+    uint32_t      mFrameErrors;
+    uint32_t      mRxBufferHighWater;
+} UartEventSource;
+
+typedef struct InterruptEventSource
+{
+    SemaphoreHandle_t mSemaphore;
+    uint32_t          mEvent;
+} InterruptEventSource;
+
+static UartEventSource      sSources[UART_NUM_MAX];
+static InterruptEventSource sInterrupts[OT_INTERRUPT_EVENT_MAX];
+static QueueSetHandle_t sQueueSet = NULL;
+static TaskHandle_t     sTask     = NULL;
+static portMUX_TYPE     sLock     = portMUX_INITIALIZER_UNLOCKED;
+
+static void addErrors(UartEventSource *aSource, uint32_t aErrors)
+{
+    portENTER_CRITICAL(&sLock);
+    aSource->mErrors |= aErrors;
+    portEXIT_CRITICAL(&sLock);
+}
+
+static void handleUartEvent(UartEventSource *aSource, const uart_event_t *aEvent)
+{
+    switch (aEvent->type)
+    {
+    case UART_DATA:
+        break;
+
+    case UART_FIFO_OVF:
+        aSource->mFifoOverflows++;
+        addErrors(aSource, OT_UART_ERROR_FIFO_OVF);
+        break;
+
+    case UART_BUFFER_FULL:
+        aSource->mBufferFullEvents++;
+        addErrors(aSource, OT_UART_ERROR_BUFFER_FULL);
+        break;
+
+    case UART_FRAME_ERR:
+    case UART_PARITY_ERR:
+        aSource->mFrameErrors++;
+        addErrors(aSource, OT_UART_ERROR_FRAME);
+        break;
+
+    default:
+        ExitNow();
+    }
+
+    // Errors are reported along with the data, the reader is woken up to handle both.
+    if (aSource->mTask != NULL)
+    {
+        xTaskNotifyGive(aSource->mTask);
+    }
+    else
+    {
+        platformVfsEventSignal(aSource->mEvent);
+    }
+
+exit:
+    return;
+}
+
+static void uartEventTask(void *aContext)
+{
+    OT_UNUSED_VARIABLE(aContext);
+
+    while (true)
+    {
+        QueueSetMemberHandle_t member = xQueueSelectFromSet(sQueueSet, portMAX_DELAY);
+
+        for (int i = 0; i < UART_NUM_MAX; i++)
+        {
+            uart_event_t event;
+
+            if (sSources[i].mQueue == member && xQueueReceive(sSources[i].mQueue, &event, 0) == pdTRUE)
+            {
+                handleUartEvent(&sSources[i], &event);
+            }
+        }
+
+        for (int i = 0; i < OT_INTERRUPT_EVENT_MAX; i++)
+        {
+            if (sInterrupts[i].mSemaphore == member && xSemaphoreTake(sInterrupts[i].mSemaphore, 0) == pdTRUE)
+            {
+                platformVfsEventSignal(sInterrupts[i].mEvent);
+            }
+        }
+    }
+}
+
+void platformUartEventInit(void)
+{
+    BaseType_t ret;
+
+    // Each interrupt source is a binary semaphore, which holds a single event.
+    sQueueSet = xQueueCreateSet(OT_UART_EVENT_QUEUE_SIZE * UART_NUM_MAX + OT_INTERRUPT_EVENT_MAX);
+    VerifyOrDie(sQueueSet != NULL, OT_EXIT_FAILURE);
+
+    ret = xTaskCreate(uartEventTask, "ot_uart_evt", OT_UART_EVENT_TASK_STACK_SIZE, NULL, OT_UART_EVENT_TASK_PRIORITY,
+                      &sTask);
+    VerifyOrDie(ret == pdPASS, OT_EXIT_FAILURE);
+}
+
+void platformUartEventDeinit(void)
+{
+    if (sTask != NULL)
+    {
+        vTaskDelete(sTask);
+        sTask = NULL;
+    }
+
+    for (int i = 0; i < UART_NUM_MAX; i++)
+    {
+        platformUartEventRemove((uart_port_t)i);
+    }
+
+    for (int i = 0; i < OT_INTERRUPT_EVENT_MAX; i++)
+    {
+        if (sInterrupts[i].mSemaphore != NULL)
+        {
+            platformInterruptEventRemove(sInterrupts[i].mSemaphore);
+        }
+    }
+
+    vQueueDelete(sQueueSet);
+    sQueueSet = NULL;
+}
+
+void platformUartEventAdd(uart_port_t aUart, QueueHandle_t aQueue, uint32_t aEvent)
+{
+    assert(sSources[aUart].mQueue == NULL);
+
+    sSources[aUart].mQueue  = aQueue;
+    sSources[aUart].mTask   = NULL;
+    sSources[aUart].mEvent  = aEvent;
+    sSources[aUart].mErrors = 0;
+    VerifyOrDie(xQueueAddToSet(aQueue, sQueueSet) == pdPASS, OT_EXIT_FAILURE);
+}
+
+void platformUartEventRemove(uart_port_t aUart)
+{
+    VerifyOrExit(sSources[aUart].mQueue != NULL, OT_NOOP);
+
+    // A queue can only leave its set once it is empty.
+    xQueueReset(sSources[aUart].mQueue);
+    xQueueRemoveFromSet(sSources[aUart].mQueue, sQueueSet);
+
+    sSources[aUart].mQueue  = NULL;
+    sSources[aUart].mTask   = NULL;
+    sSources[aUart].mEvent  = 0;
+    sSources[aUart].mErrors = 0;
+
+exit:
+    return;
+}
+
+void platformUartEventSetTask(uart_port_t aUart, TaskHandle_t aTask)
+{
+    assert(sSources[aUart].mQueue != NULL);
+
+    portENTER_CRITICAL(&sLock);
+    sSources[aUart].mTask = aTask;
+    portEXIT_CRITICAL(&sLock);
+}
+
+uint32_t platformUartEventTakeErrors(uart_port_t aUart)
+{
+    uint32_t errors;
+
+    portENTER_CRITICAL(&sLock);
+    errors                  = sSources[aUart].mErrors;
+    sSources[aUart].mErrors = 0;
+    portEXIT_CRITICAL(&sLock);
+
+    return errors;
+}
+
+void platformUartEventSampleRxLevel(uart_port_t aUart)
+{
+    size_t length = 0;
+
+    if (uart_get_buffered_data_len(aUart, &length) == ESP_OK && length > sSources[aUart].mRxBufferHighWater)
+    {
+        sSources[aUart].mRxBufferHighWater = length;
+    }
+}
+
+void platformUartEventGetStats(uart_port_t aUart, otSysUartStats *aStats)
+{
+    portENTER_CRITICAL(&sLock);
+    aStats->mFifoOverflows     = sSources[aUart].mFifoOverflows;
+    aStats->mBufferFullEvents  = sSources[aUart].mBufferFullEvents;
+    aStats->mFrameErrors       = sSources[aUart].mFrameErrors;
+    aStats->mRxBufferHighWater = sSources[aUart].mRxBufferHighWater;
+    portEXIT_CRITICAL(&sLock);
+}
+
+void platformUartEventResetStats(uart_port_t aUart)
+{
+    portENTER_CRITICAL(&sLock);
+    sSources[aUart].mFifoOverflows     = 0;
+    sSources[aUart].mBufferFullEvents  = 0;
+    sSources[aUart].mFrameErrors       = 0;
+    sSources[aUart].mRxBufferHighWater = 0;
+    portEXIT_CRITICAL(&sLock);
+}
+
+void platformInterruptEventAdd(SemaphoreHandle_t aSemaphore, uint32_t aEvent)
+{
+    int i;
+
+    for (i = 0; i < OT_INTERRUPT_EVENT_MAX && sInterrupts[i].mSemaphore != NULL; i++)
+    {
+    }
+
+    VerifyOrDie(i < OT_INTERRUPT_EVENT_MAX, OT_EXIT_FAILURE);
+
+    sInterrupts[i].mSemaphore = aSemaphore;
+    sInterrupts[i].mEvent     = aEvent;
+    VerifyOrDie(xQueueAddToSet(aSemaphore, sQueueSet) == pdPASS, OT_EXIT_FAILURE);
+}
+
+void platformInterruptEventRemove(SemaphoreHandle_t aSemaphore)
+{
+    for (int i = 0; i < OT_INTERRUPT_EVENT_MAX; i++)
+    {
+        if (sInterrupts[i].mSemaphore == aSemaphore)
+        {
+            // A semaphore can only leave its set once it is taken.
+            xSemaphoreTake(aSemaphore, 0);
+            xQueueRemoveFromSet(aSemaphore, sQueueSet);
+
+            sInterrupts[i].mSemaphore = NULL;
+            sInterrupts[i].mEvent     = 0;
+        }
+    }
+}
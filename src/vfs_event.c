@@ -40,21 +40,30 @@
 
 #include "error_handling.h"
 
+#if !OT_MAINLOOP_EVENT_GROUP_ENABLE
+
 typedef struct Event
 {
-    int     mFd;
-    bool    mIsOpen;
-    uint8_t mCounter;
-    _lock_t mLock;
+    int      mFd;
+    bool     mIsOpen;
+    uint8_t  mCounter;
+    uint32_t mSignaled;
+    _lock_t  mLock;
 } Event;
 
 static Event sEvent = {
-    .mFd      = -1,
-    .mIsOpen  = false,
-    .mCounter = 0,
-    .mLock    = 0, // lazy initialized
+    .mFd       = -1,
+    .mIsOpen   = false,
+    .mCounter  = 0,
+    .mSignaled = 0,
+    .mLock     = 0, // lazy initialized
 };
 
+/**
+ * The events signaled before the current mainloop iteration.
+ */
+static uint32_t sProcessingEvents = 0;
+
 static esp_vfs_select_sem_t sSignalSemaphore = {.is_sem_local = false, .sem = NULL};
 
 static esp_err_t event_start_select(int                  nfds,
@@ -163,8 +172,9 @@ static int event_close(int fd)
 
     VerifyOrExit(fd == sEvent.mFd && sEvent.mIsOpen, OT_NOOP);
 
-    sEvent.mIsOpen  = false;
-    sEvent.mCounter = 0;
+    sEvent.mIsOpen   = false;
+    sEvent.mCounter  = 0;
+    sEvent.mSignaled = 0;
 
     ret = 0;
 
@@ -239,6 +249,11 @@ void platformVfsEventProcess(otInstance *aInstance, const otSysMainloopContext *
 
         ESP_LOGD(OT_PLAT_LOG_TAG, "external event received, count: %d", cnt);
     }
+
+    _lock_acquire_recursive(&sEvent.mLock);
+    sProcessingEvents = sEvent.mSignaled;
+    sEvent.mSignaled  = 0;
+    _lock_release_recursive(&sEvent.mLock);
 }
 
 void platformVfsEventActivate(void)
@@ -248,3 +263,26 @@ void platformVfsEventActivate(void)
     // Write to the event fd to activate select().
     write(sEventFd, NULL, 0);
 }
+
+void platformVfsEventSignal(uint32_t aEvents)
+{
+    bool activate;
+
+    _lock_acquire_recursive(&sEvent.mLock);
+    activate = (sEvent.mSignaled & aEvents) != aEvents;
+    sEvent.mSignaled |= aEvents;
+    _lock_release_recursive(&sEvent.mLock);
+
+    // The mainloop has already been woken up for events that are still pending.
+    if (activate)
+    {
+        platformVfsEventActivate();
+    }
+}
+
+bool platformVfsEventIsSignaled(uint32_t aEvents)
+{
+    return (sProcessingEvents & aEvents) != 0;
+}
+
+#endif // !OT_MAINLOOP_EVENT_GROUP_ENABLE
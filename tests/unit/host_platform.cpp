@@ -0,0 +1,154 @@
+/*
+ *  Copyright (c) 2020, The OpenThread Authors.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  3. Neither the name of the copyright holder nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file implements the platform functions used by the radio transport for host builds.
+ *
+ *   The event file is emulated by polling the file descriptors of the host uarts, the mainloop context is not used.
+ *
+ */
+
+#include "platform-esp32.h"
+
+#include <time.h>
+
+#include <openthread/error.h>
+#include <openthread/platform/time.h>
+
+namespace {
+
+struct HostUartEvent
+{
+    QueueHandle_t mQueue;
+    uint32_t      mEvent;
+};
+
+HostUartEvent sHostUartEvents[UART_NUM_MAX] = {};
+
+} // namespace
+
+extern "C" void platformUartEventAdd(uart_port_t aUart, QueueHandle_t aQueue, uint32_t aEvent)
+{
+    sHostUartEvents[aUart].mQueue = aQueue;
+    sHostUartEvents[aUart].mEvent = aEvent;
+}
+
+extern "C" void platformUartEventRemove(uart_port_t aUart)
+{
+    sHostUartEvents[aUart].mQueue = NULL;
+    sHostUartEvents[aUart].mEvent = 0;
+}
+
+extern "C" void platformUartEventSetTask(uart_port_t aUart, TaskHandle_t aTask)
+{
+    (void)aUart;
+    (void)aTask;
+}
+
+extern "C" uint32_t platformUartEventTakeErrors(uart_port_t aUart)
+{
+    // A file descriptor neither overflows nor sees framing errors.
+    (void)aUart;
+
+    return 0;
+}
+
+extern "C" void platformUartEventSampleRxLevel(uart_port_t aUart)
+{
+    (void)aUart;
+}
+
+extern "C" void platformVfsEventSignal(uint32_t aEvents)
+{
+    (void)aEvents;
+}
+
+extern "C" bool platformVfsEventIsSignaled(uint32_t aEvents)
+{
+    bool signaled = false;
+
+    for (int port = UART_NUM_0; port < UART_NUM_MAX && !signaled; port++)
+    {
+        const HostUartEvent &event = sHostUartEvents[port];
+
+        if (event.mQueue != NULL && (event.mEvent & aEvents) != 0)
+        {
+            signaled = HostUartIsReadable(static_cast<uart_port_t>(port));
+        }
+    }
+
+    return signaled;
+}
+
+extern "C" uint64_t otPlatTimeGet(void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return static_cast<uint64_t>(now.tv_sec) * OT_US_PER_S + static_cast<uint64_t>(now.tv_nsec) / 1000;
+}
+
+extern "C" const char *otThreadErrorToString(otError aError)
+{
+    const char *string;
+
+    switch (aError)
+    {
+    case OT_ERROR_NONE:
+        string = "OK";
+        break;
+
+    case OT_ERROR_FAILED:
+        string = "Failed";
+        break;
+
+    case OT_ERROR_PARSE:
+        string = "Parse";
+        break;
+
+    case OT_ERROR_NO_BUFS:
+        string = "NoBufs";
+        break;
+
+    case OT_ERROR_NOT_IMPLEMENTED:
+        string = "NotImplemented";
+        break;
+
+    case OT_ERROR_RESPONSE_TIMEOUT:
+        string = "ResponseTimeout";
+        break;
+
+    default:
+        string = "UnknownErrorType";
+        break;
+    }
+
+    return string;
+}
@@ -0,0 +1,279 @@
+/*
+ *  Copyright (c) 2020, The OpenThread Authors.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  3. Neither the name of the copyright holder nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file implements the ESP-IDF uart driver over file descriptors for host builds.
+ *
+ *   Bytes go through the file descriptor as soon as they are written, the baud rate is only recorded. A uart driver
+ *   installed without a TX ring buffer is emulated, the writer is never blocked and `uart_tx_chars()` takes at most
+ *   a FIFO worth of bytes.
+ *
+ */
+
+#include <driver/uart.h>
+
+#include <atomic>
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <termios.h>
+#include <unistd.h>
+
+namespace {
+
+struct HostUart
+{
+    int                   mFd;
+    bool                  mAttached;
+    bool                  mInstalled;
+    std::atomic<uint32_t> mBaudRate;
+    std::atomic<bool>     mTxStalled;
+};
+
+HostUart sHostUarts[UART_NUM_MAX] = {};
+
+HostUart *GetHostUart(uart_port_t aPort)
+{
+    return (aPort >= UART_NUM_0 && aPort < UART_NUM_MAX) ? &sHostUarts[aPort] : NULL;
+}
+
+int TicksToMs(TickType_t aTicks)
+{
+    return aTicks == portMAX_DELAY ? -1 : static_cast<int>(aTicks * 1000 / configTICK_RATE_HZ);
+}
+
+} // namespace
+
+extern "C" void HostUartAttach(uart_port_t aPort, int aFd)
+{
+    HostUart *uart = GetHostUart(aPort);
+
+    ESP_ERROR_CHECK(uart != NULL && aFd >= 0 ? ESP_OK : ESP_ERR_INVALID_ARG);
+    ESP_ERROR_CHECK(fcntl(aFd, F_SETFL, fcntl(aFd, F_GETFL) | O_NONBLOCK) == 0 ? ESP_OK : ESP_FAIL);
+
+    uart->mFd       = aFd;
+    uart->mAttached = true;
+    uart->mTxStalled.store(false);
+}
+
+extern "C" uint32_t HostUartGetBaudRate(uart_port_t aPort)
+{
+    HostUart *uart = GetHostUart(aPort);
+
+    return uart != NULL ? uart->mBaudRate.load() : 0;
+}
+
+extern "C" bool HostUartIsReadable(uart_port_t aPort)
+{
+    HostUart *    uart   = GetHostUart(aPort);
+    struct pollfd pollFd = {uart != NULL && uart->mAttached ? uart->mFd : -1, POLLIN, 0};
+
+    return poll(&pollFd, 1, 0) > 0;
+}
+
+extern "C" void HostUartSetTxStalled(uart_port_t aPort, bool aStalled)
+{
+    HostUart *uart = GetHostUart(aPort);
+
+    if (uart != NULL)
+    {
+        uart->mTxStalled.store(aStalled);
+    }
+}
+
+extern "C" esp_err_t uart_param_config(uart_port_t aPort, const uart_config_t *aConfig)
+{
+    HostUart *uart = GetHostUart(aPort);
+
+    if (uart == NULL || aConfig == NULL || aConfig->baud_rate <= 0)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    uart->mBaudRate.store(static_cast<uint32_t>(aConfig->baud_rate));
+
+    return ESP_OK;
+}
+
+extern "C" esp_err_t uart_set_pin(uart_port_t aPort, int aTxdPin, int aRxdPin, int aRtsPin, int aCtsPin)
+{
+    (void)aTxdPin;
+    (void)aRxdPin;
+    (void)aRtsPin;
+    (void)aCtsPin;
+
+    return GetHostUart(aPort) != NULL ? ESP_OK : ESP_ERR_INVALID_ARG;
+}
+
+extern "C" esp_err_t uart_driver_install(uart_port_t    aPort,
+                                         int            aRxBufferSize,
+                                         int            aTxBufferSize,
+                                         int            aQueueSize,
+                                         QueueHandle_t *aQueue,
+                                         int            aIntrAllocFlags)
+{
+    HostUart *uart = GetHostUart(aPort);
+
+    (void)aRxBufferSize;
+    (void)aQueueSize;
+    (void)aIntrAllocFlags;
+
+    // Only the driver without a TX ring buffer is emulated, and the file descriptor has to be attached first.
+    if (uart == NULL || !uart->mAttached || aTxBufferSize != 0)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    if (uart->mInstalled)
+    {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    if (aQueue != NULL)
+    {
+        *aQueue = uart;
+    }
+
+    uart->mInstalled = true;
+
+    return ESP_OK;
+}
+
+extern "C" esp_err_t uart_driver_delete(uart_port_t aPort)
+{
+    HostUart *uart = GetHostUart(aPort);
+
+    if (uart == NULL || !uart->mInstalled)
+    {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    uart->mInstalled = false;
+
+    return ESP_OK;
+}
+
+extern "C" esp_err_t uart_set_baudrate(uart_port_t aPort, uint32_t aBaudRate)
+{
+    HostUart *uart = GetHostUart(aPort);
+
+    if (uart == NULL || aBaudRate == 0)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    uart->mBaudRate.store(aBaudRate);
+
+    return ESP_OK;
+}
+
+extern "C" esp_err_t uart_flush_input(uart_port_t aPort)
+{
+    HostUart *uart = GetHostUart(aPort);
+
+    if (uart == NULL || !uart->mInstalled)
+    {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    tcflush(uart->mFd, TCIFLUSH);
+
+    return ESP_OK;
+}
+
+extern "C" esp_err_t uart_wait_tx_done(uart_port_t aPort, TickType_t aTicksToWait)
+{
+    HostUart *uart = GetHostUart(aPort);
+
+    if (uart == NULL || !uart->mInstalled)
+    {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    if (uart->mTxStalled.load())
+    {
+        // The peer holds CTS for the whole wait, the FIFO is not transmitted.
+        usleep(static_cast<useconds_t>(TicksToMs(aTicksToWait)) * 1000);
+        return ESP_ERR_TIMEOUT;
+    }
+
+    return ESP_OK;
+}
+
+extern "C" int uart_read_bytes(uart_port_t aPort, uint8_t *aBuffer, uint32_t aLength, TickType_t aTicksToWait)
+{
+    HostUart *uart = GetHostUart(aPort);
+    ssize_t   rval;
+
+    if (uart == NULL || !uart->mInstalled)
+    {
+        return -1;
+    }
+
+    if (aTicksToWait > 0)
+    {
+        struct pollfd pollFd = {uart->mFd, POLLIN, 0};
+
+        poll(&pollFd, 1, TicksToMs(aTicksToWait));
+    }
+
+    rval = read(uart->mFd, aBuffer, aLength);
+
+    if (rval < 0)
+    {
+        return (errno == EAGAIN || errno == EINTR) ? 0 : -1;
+    }
+
+    return static_cast<int>(rval);
+}
+
+extern "C" int uart_tx_chars(uart_port_t aPort, const char *aBuffer, uint32_t aLength)
+{
+    HostUart *uart = GetHostUart(aPort);
+    ssize_t   rval;
+
+    if (uart == NULL || !uart->mInstalled)
+    {
+        return -1;
+    }
+
+    if (uart->mTxStalled.load())
+    {
+        return 0;
+    }
+
+    rval = write(uart->mFd, aBuffer, aLength < UART_FIFO_LEN ? aLength : UART_FIFO_LEN);
+
+    if (rval < 0)
+    {
+        return (errno == EAGAIN || errno == EINTR) ? 0 : -1;
+    }
+
+    return static_cast<int>(rval);
+}
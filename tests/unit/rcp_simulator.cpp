@@ -0,0 +1,382 @@
+/*
+ *  Copyright (c) 2020, The OpenThread Authors.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  3. Neither the name of the copyright holder nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file implements a simulated Radio Co-processor (RCP) talking HDLC framed spinel.
+ *
+ */
+
+#include "rcp_simulator.hpp"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "platform-esp32.h"
+#include "lib/spinel/spinel.h"
+
+enum
+{
+    kSpinelHeader = SPINEL_HEADER_FLAG | SPINEL_HEADER_IID_0,
+    kRxRssi       = -60,
+    kRxNoiseFloor = -100,
+    kMaxPsduSize  = 127,
+};
+
+static uint64_t Now(void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return static_cast<uint64_t>(now.tv_sec) * OT_US_PER_S + static_cast<uint64_t>(now.tv_nsec) / 1000;
+}
+
+RcpSimulator::RcpSimulator(int aFd, uart_port_t aHostPort, uint32_t aBaudRate)
+    : mFd(aFd)
+    , mHostPort(aHostPort)
+    , mDefaultBaudRate(aBaudRate)
+    , mBaudRate(aBaudRate)
+    , mBaudRateSupported(true)
+    , mResetPending(false)
+    , mRunning(false)
+    , mRxFrameInterval(0)
+    , mRxPsduLength(0)
+    , mTransmitCount(0)
+    , mInjectedFrameCount(0)
+    , mDroppedBytes(0)
+    , mNextRxFrameTime(0)
+    , mRxSequence(0)
+    , mDecodeBuffer()
+    , mDecoder(mDecodeBuffer, HandleHdlcFrame, this)
+{
+    fcntl(mFd, F_SETFL, fcntl(mFd, F_GETFL) | O_NONBLOCK);
+}
+
+RcpSimulator::~RcpSimulator(void)
+{
+    Stop();
+}
+
+void RcpSimulator::Start(void)
+{
+    mRunning.store(true);
+    mThread = std::thread(&RcpSimulator::Run, this);
+}
+
+void RcpSimulator::Stop(void)
+{
+    mRunning.store(false);
+
+    if (mThread.joinable())
+    {
+        mThread.join();
+    }
+}
+
+void RcpSimulator::SetRxFrameRate(uint32_t aFramesPerSecond, uint16_t aPsduLength)
+{
+    mRxPsduLength.store(aPsduLength);
+    mRxFrameInterval.store(aFramesPerSecond != 0 ? OT_US_PER_S / aFramesPerSecond : 0);
+}
+
+void RcpSimulator::Reset(void)
+{
+    mResetPending.store(true);
+}
+
+void RcpSimulator::Run(void)
+{
+    while (mRunning.load())
+    {
+        struct pollfd pollFd   = {mFd, POLLIN, 0};
+        uint32_t      interval = mRxFrameInterval.load();
+
+        if (poll(&pollFd, 1, kPollInterval) > 0)
+        {
+            Receive();
+        }
+
+        if (mResetPending.exchange(false))
+        {
+            mBaudRate.store(mDefaultBaudRate);
+            mDecoder.Reset();
+            mDecodeBuffer.Clear();
+            SendLastStatus(kSpinelHeader, SPINEL_STATUS_RESET_POWER_ON);
+        }
+
+        if (interval == 0)
+        {
+            mNextRxFrameTime = 0;
+            continue;
+        }
+
+        if (mNextRxFrameTime == 0)
+        {
+            mNextRxFrameTime = Now();
+        }
+
+        while (mNextRxFrameTime <= Now())
+        {
+            InjectRxFrame();
+            mNextRxFrameTime += interval;
+        }
+    }
+}
+
+void RcpSimulator::Receive(void)
+{
+    uint8_t buffer[256];
+    ssize_t rval = read(mFd, buffer, sizeof(buffer));
+
+    if (rval <= 0)
+    {
+        return;
+    }
+
+    // The bytes took their time on the wire.
+    Pace(static_cast<uint16_t>(rval));
+
+    if (!IsBaudRateMatched())
+    {
+        // Sampled at the wrong baud rate, the bytes are garbage and the partial frame is lost.
+        mDecoder.Reset();
+        mDecodeBuffer.Clear();
+        return;
+    }
+
+    mDecoder.Decode(buffer, static_cast<uint16_t>(rval));
+}
+
+void RcpSimulator::HandleHdlcFrame(void *aContext, otError aError)
+{
+    static_cast<RcpSimulator *>(aContext)->HandleHdlcFrame(aError);
+}
+
+void RcpSimulator::HandleHdlcFrame(otError aError)
+{
+    if (aError == OT_ERROR_NONE)
+    {
+        HandleFrame(mDecodeBuffer.GetFrame(), mDecodeBuffer.GetLength());
+    }
+
+    mDecodeBuffer.Clear();
+}
+
+void RcpSimulator::HandleFrame(const uint8_t *aFrame, uint16_t aLength)
+{
+    uint8_t        header;
+    unsigned int   command;
+    unsigned int   key;
+    const uint8_t *data;
+    spinel_size_t  dataLength;
+    spinel_ssize_t unpacked;
+
+    unpacked = spinel_datatype_unpack(aFrame, aLength, SPINEL_DATATYPE_COMMAND_S, &header, &command);
+
+    if (unpacked > 0 && command == SPINEL_CMD_RESET)
+    {
+        // A spinel reset keeps the baud rate.
+        SendLastStatus(kSpinelHeader, SPINEL_STATUS_RESET_SOFTWARE);
+        return;
+    }
+
+    unpacked = spinel_datatype_unpack(aFrame, aLength, SPINEL_DATATYPE_COMMAND_PROP_S SPINEL_DATATYPE_DATA_S, &header,
+                                      &command, &key, &data, &dataLength);
+
+    if (unpacked <= 0)
+    {
+        return;
+    }
+
+    if (command == SPINEL_CMD_PROP_VALUE_GET)
+    {
+        uint8_t        value[64];
+        spinel_ssize_t length = -1;
+
+        if (key == SPINEL_PROP_PROTOCOL_VERSION)
+        {
+            length = spinel_datatype_pack(value, sizeof(value),
+                                          SPINEL_DATATYPE_UINT_PACKED_S SPINEL_DATATYPE_UINT_PACKED_S,
+                                          SPINEL_PROTOCOL_VERSION_THREAD_MAJOR, SPINEL_PROTOCOL_VERSION_THREAD_MINOR);
+        }
+        else if (key == SPINEL_PROP_NCP_VERSION)
+        {
+            length = spinel_datatype_pack(value, sizeof(value), SPINEL_DATATYPE_UTF8_S, "OPENTHREAD/rcp-simulator");
+        }
+
+        if (length > 0)
+        {
+            SendPropertyIs(header, key, value, static_cast<uint16_t>(length));
+        }
+        else
+        {
+            SendLastStatus(header, SPINEL_STATUS_PROP_NOT_FOUND);
+        }
+    }
+    else if (command == SPINEL_CMD_PROP_VALUE_SET)
+    {
+        if (key == SPINEL_PROP_STREAM_RAW)
+        {
+            uint8_t ack[8];
+
+            // The transmit is done right away, without frame pending and without header update.
+            unpacked = spinel_datatype_pack(
+                ack, sizeof(ack), SPINEL_DATATYPE_UINT_PACKED_S SPINEL_DATATYPE_BOOL_S SPINEL_DATATYPE_BOOL_S,
+                SPINEL_STATUS_OK, false, false);
+            mTransmitCount++;
+            SendPropertyIs(header, SPINEL_PROP_LAST_STATUS, ack, static_cast<uint16_t>(unpacked));
+        }
+        else if (key == OT_RADIO_SPINEL_PROP_UART_BAUD_RATE)
+        {
+            uint32_t baudRate;
+
+            if (!mBaudRateSupported.load() ||
+                spinel_datatype_unpack(data, dataLength, SPINEL_DATATYPE_UINT32_S, &baudRate) <= 0 || baudRate == 0)
+            {
+                SendLastStatus(header, SPINEL_STATUS_PROP_NOT_FOUND);
+                return;
+            }
+
+            // The answer goes out at the current baud rate, the new one applies from the next byte.
+            SendPropertyIs(header, key, data, static_cast<uint16_t>(dataLength));
+            mBaudRate.store(baudRate);
+        }
+        else
+        {
+            SendPropertyIs(header, key, data, static_cast<uint16_t>(dataLength));
+        }
+    }
+}
+
+void RcpSimulator::SendLastStatus(uint8_t aHeader, uint32_t aStatus)
+{
+    uint8_t        value[8];
+    spinel_ssize_t length = spinel_datatype_pack(value, sizeof(value), SPINEL_DATATYPE_UINT_PACKED_S, aStatus);
+
+    SendPropertyIs(aHeader, SPINEL_PROP_LAST_STATUS, value, static_cast<uint16_t>(length));
+}
+
+void RcpSimulator::SendPropertyIs(uint8_t aHeader, uint32_t aKey, const uint8_t *aValue, uint16_t aLength)
+{
+    uint8_t        frame[kMaxFrameSize];
+    spinel_ssize_t length;
+
+    length = spinel_datatype_pack(frame, sizeof(frame), SPINEL_DATATYPE_COMMAND_PROP_S SPINEL_DATATYPE_DATA_S, aHeader,
+                                  SPINEL_CMD_PROP_VALUE_IS, aKey, aValue, static_cast<spinel_size_t>(aLength));
+
+    if (length > 0)
+    {
+        SendFrame(frame, static_cast<uint16_t>(length));
+    }
+}
+
+void RcpSimulator::InjectRxFrame(void)
+{
+    uint8_t        psdu[kMaxPsduSize];
+    uint8_t        frame[kMaxFrameSize];
+    uint16_t       psduLength = mRxPsduLength.load();
+    spinel_ssize_t length;
+
+    if (psduLength > sizeof(psdu))
+    {
+        psduLength = sizeof(psdu);
+    }
+
+    // A data frame with a sequence number, the payload is a counter so that escaped bytes show up regularly.
+    for (uint16_t i = 0; i < psduLength; i++)
+    {
+        psdu[i] = static_cast<uint8_t>(mRxSequence + i);
+    }
+
+    if (psduLength >= 3)
+    {
+        psdu[0] = 0x41;
+        psdu[1] = 0xd8;
+        psdu[2] = mRxSequence;
+    }
+
+    mRxSequence++;
+
+    length = spinel_datatype_pack(frame, sizeof(frame),
+                                  SPINEL_DATATYPE_COMMAND_PROP_S SPINEL_DATATYPE_DATA_WLEN_S SPINEL_DATATYPE_INT8_S
+                                      SPINEL_DATATYPE_INT8_S SPINEL_DATATYPE_UINT16_S,
+                                  kSpinelHeader, SPINEL_CMD_PROP_VALUE_IS, SPINEL_PROP_STREAM_RAW, psdu,
+                                  static_cast<spinel_size_t>(psduLength), kRxRssi, kRxNoiseFloor, 0);
+
+    if (length > 0)
+    {
+        SendFrame(frame, static_cast<uint16_t>(length));
+        mInjectedFrameCount++;
+    }
+}
+
+void RcpSimulator::SendFrame(const uint8_t *aFrame, uint16_t aLength)
+{
+    ot::Hdlc::FrameBuffer<2 * kMaxFrameSize + 8> buffer;
+    ot::Hdlc::Encoder                            encoder(buffer);
+
+    if (encoder.BeginFrame() == OT_ERROR_NONE && encoder.Encode(aFrame, aLength) == OT_ERROR_NONE &&
+        encoder.EndFrame() == OT_ERROR_NONE)
+    {
+        WriteBytes(buffer.GetFrame(), buffer.GetLength());
+    }
+}
+
+void RcpSimulator::WriteBytes(const uint8_t *aData, uint16_t aLength)
+{
+    uint8_t garbled[2 * kMaxFrameSize + 8];
+    ssize_t rval;
+
+    // The bytes are received by the host once they have been on the wire.
+    Pace(aLength);
+
+    if (!IsBaudRateMatched())
+    {
+        // Sampled at the wrong baud rate, the host sees garbage without any flag byte.
+        memset(garbled, 0xff, aLength);
+        aData = garbled;
+    }
+
+    rval = write(mFd, aData, aLength);
+
+    if (rval < aLength)
+    {
+        // The host does not read, the bytes the pseudo terminal does not take are lost like on an overflowing FIFO.
+        mDroppedBytes += aLength - (rval > 0 ? static_cast<uint16_t>(rval) : 0);
+    }
+}
+
+void RcpSimulator::Pace(uint16_t aLength)
+{
+    usleep(static_cast<useconds_t>(static_cast<uint64_t>(aLength) * kUartBitsPerByte * OT_US_PER_S / mBaudRate.load()));
+}
@@ -0,0 +1,173 @@
+/*
+ *  Copyright (c) 2020, The OpenThread Authors.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  3. Neither the name of the copyright holder nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file includes definitions for a simulated Radio Co-processor (RCP) talking HDLC framed spinel.
+ *
+ */
+
+#ifndef OT_ESP32_TEST_RCP_SIMULATOR_HPP_
+#define OT_ESP32_TEST_RCP_SIMULATOR_HPP_
+
+#include <atomic>
+#include <stdint.h>
+#include <thread>
+
+#include <driver/uart.h>
+#include <openthread/error.h>
+
+#include "lib/hdlc/hdlc.hpp"
+
+/**
+ * This class simulates an RCP on the master side of a pseudo terminal, the host uart is attached to its slave side.
+ *
+ * The simulator answers property gets and sets, acknowledges transmit requests and injects received 802.15.4 frames
+ * at a configurable rate. It supports changing its baud rate through `OT_RADIO_SPINEL_PROP_UART_BAUD_RATE`, its
+ * input and output are paced to its baud rate, and bytes are garbled in both directions while its baud rate differs
+ * from the one of the host uart.
+ *
+ */
+class RcpSimulator
+{
+public:
+    /**
+     * This constructor initializes the simulator.
+     *
+     * @param[in]  aFd        The master side of the pseudo terminal.
+     * @param[in]  aHostPort  The host uart attached to the slave side.
+     * @param[in]  aBaudRate  The baud rate after a hardware reset.
+     *
+     */
+    RcpSimulator(int aFd, uart_port_t aHostPort, uint32_t aBaudRate);
+
+    /**
+     * This destructor stops the simulator.
+     *
+     */
+    ~RcpSimulator(void);
+
+    /**
+     * This method starts the simulator thread.
+     *
+     */
+    void Start(void);
+
+    /**
+     * This method stops the simulator thread.
+     *
+     */
+    void Stop(void);
+
+    /**
+     * This method sets the rate of received frames injected to the host.
+     *
+     * @param[in]  aFramesPerSecond  The number of frames per second, 0 stops the injection.
+     * @param[in]  aPsduLength       The length of the injected PSDUs.
+     *
+     */
+    void SetRxFrameRate(uint32_t aFramesPerSecond, uint16_t aPsduLength);
+
+    /**
+     * This method simulates a hardware reset, the RCP is back at its default baud rate and reports the reset.
+     *
+     */
+    void Reset(void);
+
+    /**
+     * This method enables or disables the support of `OT_RADIO_SPINEL_PROP_UART_BAUD_RATE`.
+     *
+     */
+    void SetBaudRateSupported(bool aSupported) { mBaudRateSupported.store(aSupported); }
+
+    /**
+     * This method returns the current baud rate of the simulator.
+     *
+     */
+    uint32_t GetBaudRate(void) const { return mBaudRate.load(); }
+
+    /**
+     * This method returns the number of transmit requests acknowledged.
+     *
+     */
+    uint32_t GetTransmitCount(void) const { return mTransmitCount.load(); }
+
+    /**
+     * This method returns the number of received frames injected to the host.
+     *
+     */
+    uint32_t GetInjectedFrameCount(void) const { return mInjectedFrameCount.load(); }
+
+    /**
+     * This method returns the number of bytes dropped because the pseudo terminal was full.
+     *
+     */
+    uint32_t GetDroppedBytes(void) const { return mDroppedBytes.load(); }
+
+private:
+    enum
+    {
+        kMaxFrameSize    = 2048,
+        kUartBitsPerByte = 10,
+        kPollInterval    = 1, ///< Milliseconds.
+    };
+
+    void Run(void);
+    void Receive(void);
+    void HandleFrame(const uint8_t *aFrame, uint16_t aLength);
+    void SendFrame(const uint8_t *aFrame, uint16_t aLength);
+    void SendLastStatus(uint8_t aHeader, uint32_t aStatus);
+    void SendPropertyIs(uint8_t aHeader, uint32_t aKey, const uint8_t *aValue, uint16_t aLength);
+    void InjectRxFrame(void);
+    void WriteBytes(const uint8_t *aData, uint16_t aLength);
+    void Pace(uint16_t aLength);
+    bool IsBaudRateMatched(void) const { return HostUartGetBaudRate(mHostPort) == mBaudRate.load(); }
+
+    static void HandleHdlcFrame(void *aContext, otError aError);
+    void        HandleHdlcFrame(otError aError);
+
+    int                                   mFd;
+    uart_port_t                           mHostPort;
+    uint32_t                              mDefaultBaudRate;
+    std::atomic<uint32_t>                 mBaudRate;
+    std::atomic<bool>                     mBaudRateSupported;
+    std::atomic<bool>                     mResetPending;
+    std::atomic<bool>                     mRunning;
+    std::atomic<uint32_t>                 mRxFrameInterval; ///< Microseconds, 0 when not injecting.
+    std::atomic<uint16_t>                 mRxPsduLength;
+    std::atomic<uint32_t>                 mTransmitCount;
+    std::atomic<uint32_t>                 mInjectedFrameCount;
+    std::atomic<uint32_t>                 mDroppedBytes;
+    uint64_t                              mNextRxFrameTime;
+    uint8_t                               mRxSequence;
+    ot::Hdlc::FrameBuffer<kMaxFrameSize>  mDecodeBuffer;
+    ot::Hdlc::Decoder                     mDecoder;
+    std::thread                           mThread;
+};
+
+#endif // OT_ESP32_TEST_RCP_SIMULATOR_HPP_
@@ -0,0 +1,152 @@
+/*
+ *  Copyright (c) 2020, The OpenThread Authors.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  3. Neither the name of the copyright holder nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file provides the ESP-IDF uart driver API for host builds.
+ *
+ *   The host implementation in host_uart.cpp runs each uart over a file descriptor attached with `HostUartAttach()`,
+ *   typically the slave side of a pseudo terminal.
+ *
+ */
+
+#ifndef OT_ESP32_TEST_DRIVER_UART_H_
+#define OT_ESP32_TEST_DRIVER_UART_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "esp_err.h"
+#include "freertos/FreeRTOS.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define UART_FIFO_LEN 128
+#define UART_PIN_NO_CHANGE (-1)
+
+typedef enum
+{
+    UART_NUM_0,
+    UART_NUM_1,
+    UART_NUM_2,
+    UART_NUM_MAX,
+} uart_port_t;
+
+typedef enum
+{
+    UART_DATA_5_BITS,
+    UART_DATA_6_BITS,
+    UART_DATA_7_BITS,
+    UART_DATA_8_BITS,
+} uart_word_length_t;
+
+typedef enum
+{
+    UART_PARITY_DISABLE,
+    UART_PARITY_EVEN = 2,
+    UART_PARITY_ODD  = 3,
+} uart_parity_t;
+
+typedef enum
+{
+    UART_STOP_BITS_1   = 1,
+    UART_STOP_BITS_1_5 = 2,
+    UART_STOP_BITS_2   = 3,
+} uart_stop_bits_t;
+
+typedef enum
+{
+    UART_HW_FLOWCTRL_DISABLE,
+    UART_HW_FLOWCTRL_RTS,
+    UART_HW_FLOWCTRL_CTS,
+    UART_HW_FLOWCTRL_CTS_RTS,
+} uart_hw_flowcontrol_t;
+
+typedef struct
+{
+    int                   baud_rate;
+    uart_word_length_t    data_bits;
+    uart_parity_t         parity;
+    uart_stop_bits_t      stop_bits;
+    uart_hw_flowcontrol_t flow_ctrl;
+    uint8_t               rx_flow_ctrl_thresh;
+    bool                  use_ref_tick;
+} uart_config_t;
+
+esp_err_t uart_param_config(uart_port_t aPort, const uart_config_t *aConfig);
+esp_err_t uart_set_pin(uart_port_t aPort, int aTxdPin, int aRxdPin, int aRtsPin, int aCtsPin);
+esp_err_t uart_driver_install(uart_port_t    aPort,
+                              int            aRxBufferSize,
+                              int            aTxBufferSize,
+                              int            aQueueSize,
+                              QueueHandle_t *aQueue,
+                              int            aIntrAllocFlags);
+esp_err_t uart_driver_delete(uart_port_t aPort);
+esp_err_t uart_set_baudrate(uart_port_t aPort, uint32_t aBaudRate);
+esp_err_t uart_flush_input(uart_port_t aPort);
+esp_err_t uart_wait_tx_done(uart_port_t aPort, TickType_t aTicksToWait);
+int       uart_read_bytes(uart_port_t aPort, uint8_t *aBuffer, uint32_t aLength, TickType_t aTicksToWait);
+int       uart_tx_chars(uart_port_t aPort, const char *aBuffer, uint32_t aLength);
+
+/**
+ * This function attaches a file descriptor to a host uart, it MUST be called before the uart driver is installed.
+ *
+ * @param[in]  aPort  The uart port.
+ * @param[in]  aFd    The file descriptor, it is switched to non-blocking mode.
+ *
+ */
+void HostUartAttach(uart_port_t aPort, int aFd);
+
+/**
+ * This function returns the baud rate a host uart is configured for.
+ *
+ * The file descriptor does not carry the baud rate, peers compare it with their own to emulate a baud rate mismatch.
+ *
+ */
+uint32_t HostUartGetBaudRate(uart_port_t aPort);
+
+/**
+ * This function indicates whether a host uart has received bytes which have not been read yet.
+ *
+ */
+bool HostUartIsReadable(uart_port_t aPort);
+
+/**
+ * This function emulates the peer holding CTS, the uart FIFO is not transmitted while stalled.
+ *
+ */
+void HostUartSetTxStalled(uart_port_t aPort, bool aStalled);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif // OT_ESP32_TEST_DRIVER_UART_H_
@@ -0,0 +1,52 @@
+/*
+ *  Copyright (c) 2020, The OpenThread Authors.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  3. Neither the name of the copyright holder nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ *   This file provides the ESP-IDF logging macros for host builds, debug and verbose logs are dropped.
+ *
+ */
+
+#ifndef OT_ESP32_TEST_ESP_LOG_H_
+#define OT_ESP32_TEST_ESP_LOG_H_
+
+#include <stdio.h>
+
+#define ESP_LOGE(aTag, aFormat, ...) fprintf(stderr, "E %s: " aFormat "\n", aTag, ##__VA_ARGS__)
+#define ESP_LOGW(aTag, aFormat, ...) fprintf(stderr, "W %s: " aFormat "\n", aTag, ##__VA_ARGS__)
+#define ESP_LOGI(aTag, aFormat, ...) fprintf(stderr, "I %s: " aFormat "\n", aTag, ##__VA_ARGS__)
+#define ESP_LOGD(aTag, aFormat, ...) \
+    do                               \
+    {                                \
+    } while (0)
+#define ESP_LOGV(aTag, aFormat, ...) \
+    do                               \
+    {                                \
+    } while (0)
+
+#endif // OT_ESP32_TEST_ESP_LOG_H_
@@ -0,0 +1,622 @@
+/*
+ *  Copyright (c) 2020, The OpenThread Authors.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  3. Neither the name of the copyright holder nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <chrono>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <vector>
+
+#include "hdlc_codec.hpp"
+#include "ring_buffer.hpp"
+#include "test_util.h"
+
+using ot::Esp32::HdlcDecoder;
+using ot::Esp32::HdlcEncoder;
+using ot::Esp32::HdlcFcs;
+using ot::Esp32::RingBuffer;
+
+enum
+{
+    kMaxFrameSize      = 1500,
+    kEncodedBufferSize = 2 * kMaxFrameSize + 16,
+    kRandomSeed        = 0x2a5e1d3b,
+};
+
+static const uint8_t kEscapeHeavyBytes[] = {0x7e, 0x7d, 0x11, 0x13, 0xf8, 0x00, 0xff, 0x5e};
+
+static uint32_t sRandomState = kRandomSeed;
+
+static uint32_t Random(void)
+{
+    // xorshift32, reproducible across hosts.
+    sRandomState ^= sRandomState << 13;
+    sRandomState ^= sRandomState >> 17;
+    sRandomState ^= sRandomState << 5;
+
+    return sRandomState;
+}
+
+static uint16_t RandomLength(uint16_t aMin, uint16_t aMax)
+{
+    return static_cast<uint16_t>(aMin + Random() % (aMax - aMin + 1));
+}
+
+static std::vector<uint8_t> RandomFrame(uint16_t aLength, bool aEscapeHeavy)
+{
+    std::vector<uint8_t> frame(aLength);
+
+    for (uint8_t &byte : frame)
+    {
+        if (aEscapeHeavy && (Random() % 4) != 0)
+        {
+            byte = kEscapeHeavyBytes[Random() % sizeof(kEscapeHeavyBytes)];
+        }
+        else
+        {
+            byte = static_cast<uint8_t>(Random());
+        }
+    }
+
+    return frame;
+}
+
+static uint16_t ReferenceFcs(const uint8_t *aData, uint16_t aLength)
+{
+    uint16_t fcs = HdlcFcs::kInitFcs;
+
+    while (aLength-- > 0)
+    {
+        fcs ^= *aData++;
+
+        for (uint8_t bit = 0; bit < 8; bit++)
+        {
+            fcs = (fcs & 1) ? static_cast<uint16_t>((fcs >> 1) ^ 0x8408) : static_cast<uint16_t>(fcs >> 1);
+        }
+    }
+
+    return fcs;
+}
+
+static std::vector<uint8_t> ReferenceEncode(const std::vector<uint8_t> &aFrame)
+{
+    ot::Hdlc::FrameBuffer<kEncodedBufferSize> buffer;
+    ot::Hdlc::Encoder                         encoder(buffer);
+
+    SuccessOrQuit(encoder.BeginFrame(), "reference BeginFrame() failed");
+    SuccessOrQuit(encoder.Encode(aFrame.data(), static_cast<uint16_t>(aFrame.size())), "reference Encode() failed");
+    SuccessOrQuit(encoder.EndFrame(), "reference EndFrame() failed");
+
+    return std::vector<uint8_t>(buffer.GetFrame(), buffer.GetFrame() + buffer.GetLength());
+}
+
+static std::vector<uint8_t> Encode(const std::vector<uint8_t> &aFrame, uint16_t aMaxChunkSize)
+{
+    HdlcEncoder          encoder;
+    std::vector<uint8_t> encoded;
+    uint8_t              chunk[HdlcEncoder::kMaxEndFrameSize + 64];
+    uint16_t             consumed = 0;
+    uint16_t             length;
+
+    length = encoder.BeginFrame(chunk);
+    encoded.insert(encoded.end(), chunk, chunk + length);
+
+    // Hand out output chunks of varying size, as the UART TX ring buffer does.
+    while (consumed < aFrame.size())
+    {
+        length = RandomLength(1, aMaxChunkSize);
+        consumed += encoder.Encode(aFrame.data() + consumed, static_cast<uint16_t>(aFrame.size() - consumed), chunk,
+                                   length);
+        encoded.insert(encoded.end(), chunk, chunk + length);
+    }
+
+    length = encoder.EndFrame(chunk);
+    encoded.insert(encoded.end(), chunk, chunk + length);
+
+    return encoded;
+}
+
+/**
+ * This class collects the frames and errors reported by a decoder.
+ *
+ */
+template <uint16_t kBufferSize> class FrameRecorder
+{
+public:
+    struct Result
+    {
+        otError              mError;
+        std::vector<uint8_t> mFrame;
+
+        bool operator==(const Result &aOther) const { return mError == aOther.mError && mFrame == aOther.mFrame; }
+    };
+
+    static void HandleFrame(void *aContext, otError aError)
+    {
+        static_cast<FrameRecorder *>(aContext)->HandleFrame(aError);
+    }
+
+    void HandleFrame(otError aError)
+    {
+        Result result;
+
+        result.mError = aError;
+
+        if (aError == OT_ERROR_NONE)
+        {
+            result.mFrame.assign(mBuffer.GetFrame(), mBuffer.GetFrame() + mBuffer.GetLength());
+        }
+
+        mResults.push_back(result);
+        mBuffer.Clear();
+    }
+
+    ot::Hdlc::FrameBuffer<kBufferSize> mBuffer;
+    std::vector<Result>                mResults;
+};
+
+template <uint16_t kBufferSize> static void CompareDecoders(const std::vector<uint8_t> &aStream, const char *aName)
+{
+    FrameRecorder<kBufferSize> reference;
+    FrameRecorder<kBufferSize> recorder;
+    ot::Hdlc::Decoder          referenceDecoder(reference.mBuffer, FrameRecorder<kBufferSize>::HandleFrame, &reference);
+    HdlcDecoder                decoder(recorder.mBuffer, FrameRecorder<kBufferSize>::HandleFrame, &recorder);
+    size_t                     offset = 0;
+
+    // Feed both decoders the same pieces, as they come out of the UART driver.
+    while (offset < aStream.size())
+    {
+        uint16_t length = RandomLength(1, 300);
+
+        if (length > aStream.size() - offset)
+        {
+            length = static_cast<uint16_t>(aStream.size() - offset);
+        }
+
+        referenceDecoder.Decode(aStream.data() + offset, length);
+        decoder.Decode(aStream.data() + offset, length);
+        offset += length;
+    }
+
+    VerifyOrQuit(!reference.mResults.empty(), aName);
+    VerifyOrQuit(reference.mResults == recorder.mResults, aName);
+}
+
+void TestHdlcFcs(void)
+{
+    HdlcFcs::Init();
+
+    for (uint16_t i = 0; i < 1000; i++)
+    {
+        std::vector<uint8_t> frame  = RandomFrame(RandomLength(0, 300), (i % 2) != 0);
+        uint16_t             offset = static_cast<uint16_t>(frame.empty() ? 0 : Random() % frame.size());
+        uint16_t             length = static_cast<uint16_t>(frame.size() - offset);
+        uint16_t             fcs;
+
+        // Start at any offset to cover unaligned table lookups and short tails.
+        fcs = HdlcFcs::Update(HdlcFcs::kInitFcs, frame.data() + offset, length);
+        VerifyOrQuit(fcs == ReferenceFcs(frame.data() + offset, length), "FCS differs from the bitwise reference");
+
+        fcs ^= 0xffff;
+        frame.push_back(static_cast<uint8_t>(fcs & 0xff));
+        frame.push_back(static_cast<uint8_t>(fcs >> 8));
+        VerifyOrQuit(HdlcFcs::Update(HdlcFcs::kInitFcs, frame.data() + offset, length + HdlcFcs::kFcsSize) ==
+                         HdlcFcs::kGoodFcs,
+                     "FCS over a frame including its FCS is not good");
+    }
+
+    printf("TestHdlcFcs PASSED\n");
+}
+
+void TestHdlcEncoder(void)
+{
+    for (uint16_t i = 0; i < 1000; i++)
+    {
+        bool                 escapeHeavy = (i % 2) != 0;
+        std::vector<uint8_t> frame       = RandomFrame(RandomLength(0, kMaxFrameSize), escapeHeavy);
+        std::vector<uint8_t> expected    = ReferenceEncode(frame);
+
+        VerifyOrQuit(Encode(frame, 64) == expected, "encoding differs from ot::Hdlc::Encoder");
+        VerifyOrQuit(Encode(frame, 2) == expected, "encoding into tiny chunks differs from ot::Hdlc::Encoder");
+    }
+
+    printf("TestHdlcEncoder PASSED\n");
+}
+
+void TestHdlcRoundTrip(void)
+{
+    std::vector<uint8_t> stream;
+    std::vector<uint8_t> frames[200];
+
+    for (uint16_t i = 0; i < sizeof(frames) / sizeof(frames[0]); i++)
+    {
+        std::vector<uint8_t> encoded;
+
+        frames[i] = RandomFrame(RandomLength(1, kMaxFrameSize), (i % 3) == 0);
+        encoded   = Encode(frames[i], 64);
+        stream.insert(stream.end(), encoded.begin(), encoded.end());
+    }
+
+    {
+        FrameRecorder<kMaxFrameSize> recorder;
+        HdlcDecoder                  decoder(recorder.mBuffer, FrameRecorder<kMaxFrameSize>::HandleFrame, &recorder);
+
+        for (size_t offset = 0; offset < stream.size(); offset += 0x8000)
+        {
+            size_t length = stream.size() - offset;
+
+            decoder.Decode(stream.data() + offset, static_cast<uint16_t>(length > 0x8000 ? 0x8000 : length));
+        }
+
+        VerifyOrQuit(recorder.mResults.size() == sizeof(frames) / sizeof(frames[0]), "round trip lost frames");
+
+        for (uint16_t i = 0; i < sizeof(frames) / sizeof(frames[0]); i++)
+        {
+            VerifyOrQuit(recorder.mResults[i].mError == OT_ERROR_NONE, "round trip frame has an error");
+            VerifyOrQuit(recorder.mResults[i].mFrame == frames[i], "round trip frame differs");
+        }
+    }
+
+    CompareDecoders<kMaxFrameSize>(stream, "decoding differs from ot::Hdlc::Decoder");
+
+    printf("TestHdlcRoundTrip PASSED\n");
+}
+
+void TestHdlcDecoderErrors(void)
+{
+    std::vector<uint8_t> stream;
+
+    // Noise before the first flag, corrupted FCS, truncated frames and empty frames between the good ones.
+    for (uint16_t i = 0; i < 300; i++)
+    {
+        std::vector<uint8_t> frame   = RandomFrame(RandomLength(1, 200), (i % 2) != 0);
+        std::vector<uint8_t> encoded = ReferenceEncode(frame);
+
+        switch (Random() % 5)
+        {
+        case 0:
+            encoded[1 + Random() % (encoded.size() - 2)] ^= static_cast<uint8_t>(1 + Random() % 0xff);
+            break;
+
+        case 1:
+            encoded.resize(1 + Random() % (encoded.size() - 1));
+            break;
+
+        case 2:
+            encoded.insert(encoded.begin(), 0x7e);
+            break;
+
+        default:
+            break;
+        }
+
+        stream.insert(stream.end(), encoded.begin(), encoded.end());
+    }
+
+    CompareDecoders<kMaxFrameSize>(stream, "error handling differs from ot::Hdlc::Decoder");
+
+    // Frames larger than the frame buffer.
+    stream.clear();
+
+    for (uint16_t i = 0; i < 300; i++)
+    {
+        std::vector<uint8_t> encoded = ReferenceEncode(RandomFrame(RandomLength(1, 130), (i % 2) != 0));
+
+        stream.insert(stream.end(), encoded.begin(), encoded.end());
+    }
+
+    CompareDecoders<64>(stream, "buffer overflow handling differs from ot::Hdlc::Decoder");
+
+    printf("TestHdlcDecoderErrors PASSED\n");
+}
+
+void TestHdlcDecoderReset(void)
+{
+    FrameRecorder<kMaxFrameSize> recorder;
+    HdlcDecoder                  decoder(recorder.mBuffer, FrameRecorder<kMaxFrameSize>::HandleFrame, &recorder);
+    std::vector<uint8_t>         lost     = ReferenceEncode(RandomFrame(100, false));
+    std::vector<uint8_t>         frame    = RandomFrame(100, true);
+    std::vector<uint8_t>         received = ReferenceEncode(frame);
+
+    // Bytes lost in the middle of a frame, e.g. by a UART FIFO overflow.
+    decoder.Decode(lost.data(), static_cast<uint16_t>(lost.size() / 2));
+    VerifyOrQuit(!recorder.mBuffer.IsEmpty(), "partial frame was not written to the frame buffer");
+
+    decoder.Reset();
+    VerifyOrQuit(recorder.mBuffer.IsEmpty(), "Reset() did not discard the partial frame");
+
+    decoder.Decode(lost.data() + lost.size() / 2, static_cast<uint16_t>(lost.size() - lost.size() / 2));
+    decoder.Decode(received.data(), static_cast<uint16_t>(received.size()));
+
+    VerifyOrQuit(recorder.mResults.size() == 1, "unexpected frames after Reset()");
+    VerifyOrQuit(recorder.mResults[0].mError == OT_ERROR_NONE, "frame after Reset() has an error");
+    VerifyOrQuit(recorder.mResults[0].mFrame == frame, "frame after Reset() differs");
+
+    printf("TestHdlcDecoderReset PASSED\n");
+}
+
+void TestHdlcBenchmark(void)
+{
+    enum
+    {
+        kFrameSize   = 127,
+        kFrameCount  = 20000,
+        kOutputChunk = 256,
+    };
+
+    std::vector<std::vector<uint8_t>> frames;
+    std::vector<uint8_t>              stream;
+    FrameRecorder<kMaxFrameSize>      recorder;
+    uint8_t                           chunk[kOutputChunk];
+    size_t                            inputBytes = 0;
+    double                            referenceEncodeTime;
+    double                            encodeTime;
+    double                            referenceDecodeTime;
+    double                            decodeTime;
+
+    for (uint16_t i = 0; i < 64; i++)
+    {
+        frames.push_back(RandomFrame(kFrameSize, false));
+    }
+
+    {
+        auto start = std::chrono::steady_clock::now();
+
+        for (uint32_t i = 0; i < kFrameCount; i++)
+        {
+            std::vector<uint8_t> encoded = ReferenceEncode(frames[i % frames.size()]);
+
+            inputBytes += kFrameSize;
+
+            if (i < frames.size())
+            {
+                stream.insert(stream.end(), encoded.begin(), encoded.end());
+            }
+        }
+
+        referenceEncodeTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    {
+        HdlcEncoder encoder;
+        uint32_t    checksum = 0;
+        auto        start    = std::chrono::steady_clock::now();
+
+        for (uint32_t i = 0; i < kFrameCount; i++)
+        {
+            const std::vector<uint8_t> &frame    = frames[i % frames.size()];
+            uint16_t                    consumed = 0;
+            uint16_t                    length   = encoder.BeginFrame(chunk);
+
+            while (consumed < frame.size())
+            {
+                length = sizeof(chunk) - HdlcEncoder::kMaxEndFrameSize;
+                consumed += encoder.Encode(frame.data() + consumed, static_cast<uint16_t>(frame.size() - consumed),
+                                           chunk, length);
+            }
+
+            length = encoder.EndFrame(chunk);
+            checksum += chunk[length - 2];
+        }
+
+        encodeTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        VerifyOrQuit(checksum != 0, "benchmark encoder did not run");
+    }
+
+    {
+        ot::Hdlc::Decoder decoder(recorder.mBuffer, FrameRecorder<kMaxFrameSize>::HandleFrame, &recorder);
+        auto              start = std::chrono::steady_clock::now();
+
+        for (uint32_t i = 0; i < kFrameCount / frames.size(); i++)
+        {
+            decoder.Decode(stream.data(), static_cast<uint16_t>(stream.size()));
+        }
+
+        referenceDecodeTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    recorder.mResults.clear();
+
+    {
+        HdlcDecoder decoder(recorder.mBuffer, FrameRecorder<kMaxFrameSize>::HandleFrame, &recorder);
+        auto        start = std::chrono::steady_clock::now();
+
+        for (uint32_t i = 0; i < kFrameCount / frames.size(); i++)
+        {
+            decoder.Decode(stream.data(), static_cast<uint16_t>(stream.size()));
+        }
+
+        decodeTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    VerifyOrQuit(recorder.mResults.size() == kFrameCount / frames.size() * frames.size(), "benchmark lost frames");
+
+    printf("TestHdlcBenchmark %zu bytes in %u frames of %u bytes\n", inputBytes, kFrameCount, kFrameSize);
+    printf("    encode: ot::Hdlc %.1f MB/s, HdlcEncoder %.1f MB/s\n", inputBytes / referenceEncodeTime / (1024 * 1024),
+           inputBytes / encodeTime / (1024 * 1024));
+    printf("    decode: ot::Hdlc %.1f MB/s, HdlcDecoder %.1f MB/s\n", stream.size() * (kFrameCount / frames.size()) /
+                                                                           referenceDecodeTime / (1024 * 1024),
+           stream.size() * (kFrameCount / frames.size()) / decodeTime / (1024 * 1024));
+}
+
+/**
+ * This class counts the spinel frames decoded on the radio receive path.
+ *
+ */
+class SpinelFrameCounter
+{
+public:
+    static void HandleFrame(void *aContext, otError aError)
+    {
+        static_cast<SpinelFrameCounter *>(aContext)->HandleFrame(aError);
+    }
+
+    void HandleFrame(otError aError)
+    {
+        VerifyOrQuit(aError == OT_ERROR_NONE, "receive path dropped a frame");
+        VerifyOrQuit(mBuffer.GetLength() > 3 && mBuffer.GetFrame()[2] == kPropStreamRaw, "receive path frame is wrong");
+
+        mFrames++;
+        mBytes += mBuffer.GetLength();
+        mBuffer.Clear();
+    }
+
+    enum
+    {
+        kHeader        = 0x80, // SPINEL_HEADER_FLAG | SPINEL_HEADER_IID_0, no TID for unsolicited frames.
+        kCmdPropIs     = 6,    // SPINEL_CMD_PROP_VALUE_IS
+        kPropStreamRaw = 0x71, // SPINEL_PROP_STREAM_RAW
+    };
+
+    ot::Hdlc::FrameBuffer<kMaxFrameSize> mBuffer;
+    uint32_t                             mFrames = 0;
+    uint64_t                             mBytes  = 0;
+};
+
+static std::vector<uint8_t> StreamRawFrame(uint16_t aPsduLength)
+{
+    std::vector<uint8_t> frame = {SpinelFrameCounter::kHeader, SpinelFrameCounter::kCmdPropIs,
+                                  SpinelFrameCounter::kPropStreamRaw};
+    std::vector<uint8_t> psdu  = RandomFrame(aPsduLength, false);
+
+    // The received 802.15.4 frame, as the RCP reports it: PSDU length, PSDU, RSSI, noise floor and flags, followed by
+    // the channel, LQI and timestamp metadata.
+    frame.push_back(static_cast<uint8_t>(aPsduLength));
+    frame.push_back(static_cast<uint8_t>(aPsduLength >> 8));
+    frame.insert(frame.end(), psdu.begin(), psdu.end());
+    frame.push_back(static_cast<uint8_t>(-60));
+    frame.push_back(static_cast<uint8_t>(-100));
+    frame.push_back(0);
+    frame.push_back(0);
+    frame.push_back(static_cast<uint8_t>(11 + Random() % 16));
+    frame.push_back(static_cast<uint8_t>(Random()));
+
+    for (uint8_t i = 0; i < 8; i++)
+    {
+        frame.push_back(static_cast<uint8_t>(Random()));
+    }
+
+    return frame;
+}
+
+void TestRadioReceivePathThroughput(void)
+{
+    enum
+    {
+        kRxBufferSize    = 2048, // HdlcInterface::kRxBufferSize
+        kMaxUartRead     = 120,  // The UART driver hands out at most a full FIFO at a time.
+        kFrameCount      = 512,
+        kRounds          = 200,
+        kUartBaudRate    = 921600,
+        kUartBitsPerByte = 10,
+    };
+
+    static uint8_t       storage[kRxBufferSize];
+    std::vector<uint8_t> stream;
+    std::vector<uint8_t> readSizes;
+    RingBuffer           ringBuffer;
+    SpinelFrameCounter   counter;
+    HdlcDecoder          decoder(counter.mBuffer, SpinelFrameCounter::HandleFrame, &counter);
+    size_t               readIndex = 0;
+    double               elapsed;
+
+    for (uint16_t i = 0; i < kFrameCount; i++)
+    {
+        std::vector<uint8_t> encoded = Encode(StreamRawFrame(RandomLength(5, 127)), 64);
+
+        stream.insert(stream.end(), encoded.begin(), encoded.end());
+    }
+
+    for (uint16_t i = 0; i < 1024; i++)
+    {
+        readSizes.push_back(static_cast<uint8_t>(RandomLength(1, kMaxUartRead)));
+    }
+
+    ringBuffer.Init(storage, sizeof(storage));
+
+    auto start = std::chrono::steady_clock::now();
+
+    for (uint32_t round = 0; round < kRounds; round++)
+    {
+        size_t offset = 0;
+
+        while (offset < stream.size())
+        {
+            uint16_t length;
+            uint8_t *buffer = ringBuffer.GetWritePointer(length);
+            uint16_t read   = readSizes[readIndex++ % readSizes.size()];
+
+            // A UART read into the receive ring buffer, followed by decoding in place as HdlcInterface does.
+            if (read > length)
+            {
+                read = length;
+            }
+
+            if (read > stream.size() - offset)
+            {
+                read = static_cast<uint16_t>(stream.size() - offset);
+            }
+
+            memcpy(buffer, stream.data() + offset, read);
+            ringBuffer.CommitWrite(read);
+            offset += read;
+
+            while (!ringBuffer.IsEmpty())
+            {
+                const uint8_t *data = ringBuffer.GetReadPointer(length);
+
+                decoder.Decode(data, length);
+                ringBuffer.CommitRead(length);
+            }
+        }
+    }
+
+    elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    VerifyOrQuit(counter.mFrames == static_cast<uint32_t>(kFrameCount) * kRounds, "receive path lost frames");
+
+    printf("TestRadioReceivePathThroughput %u spinel frames, %zu bytes on the wire in %.3f s\n", counter.mFrames,
+           stream.size() * kRounds, elapsed);
+    printf("    %.0f frames/s, %.1f MB/s on the wire, %.1f MB/s of spinel frames, %.0fx a %u baud link\n",
+           counter.mFrames / elapsed, stream.size() * kRounds / elapsed / (1024 * 1024),
+           counter.mBytes / elapsed / (1024 * 1024),
+           stream.size() * kRounds / elapsed / (kUartBaudRate / kUartBitsPerByte), kUartBaudRate);
+}
+
+int main(void)
+{
+    TestHdlcFcs();
+    TestHdlcEncoder();
+    TestHdlcRoundTrip();
+    TestHdlcDecoderErrors();
+    TestHdlcDecoderReset();
+    TestHdlcBenchmark();
+    TestRadioReceivePathThroughput();
+    printf("All tests passed\n");
+    return 0;
+}
@@ -0,0 +1,312 @@
+/*
+ *  Copyright (c) 2020, The OpenThread Authors.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  3. Neither the name of the copyright holder nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "ring_buffer.hpp"
+#include "test_util.h"
+
+using ot::Esp32::RingBuffer;
+
+enum
+{
+    kBufferSize = 64,
+};
+
+static uint16_t WriteBytes(RingBuffer &aRingBuffer, const uint8_t *aData, uint16_t aLength)
+{
+    uint16_t written = 0;
+
+    while (written < aLength)
+    {
+        uint16_t length;
+        uint8_t *dst = aRingBuffer.GetWritePointer(length);
+
+        if (length == 0)
+        {
+            break;
+        }
+
+        if (length > aLength - written)
+        {
+            length = static_cast<uint16_t>(aLength - written);
+        }
+
+        memcpy(dst, aData + written, length);
+        aRingBuffer.CommitWrite(length);
+        written = static_cast<uint16_t>(written + length);
+    }
+
+    return written;
+}
+
+static uint16_t ReadBytes(RingBuffer &aRingBuffer, uint8_t *aData, uint16_t aLength)
+{
+    uint16_t read = 0;
+
+    while (read < aLength)
+    {
+        uint16_t       length;
+        const uint8_t *src = aRingBuffer.GetReadPointer(length);
+
+        if (length == 0)
+        {
+            break;
+        }
+
+        if (length > aLength - read)
+        {
+            length = static_cast<uint16_t>(aLength - read);
+        }
+
+        memcpy(aData + read, src, length);
+        aRingBuffer.CommitRead(length);
+        read = static_cast<uint16_t>(read + length);
+    }
+
+    return read;
+}
+
+void TestRingBufferEmpty(void)
+{
+    uint8_t        storage[kBufferSize];
+    RingBuffer     ringBuffer;
+    uint16_t       length;
+    const uint8_t *readPointer;
+    uint8_t *      writePointer;
+
+    ringBuffer.Init(storage, sizeof(storage));
+
+    VerifyOrQuit(ringBuffer.IsEmpty(), "new ring buffer is not empty");
+    VerifyOrQuit(ringBuffer.GetLength() == 0, "new ring buffer has non-zero length");
+    VerifyOrQuit(ringBuffer.GetFreeSpace() == kBufferSize, "new ring buffer free space is wrong");
+
+    readPointer = ringBuffer.GetReadPointer(length);
+    VerifyOrQuit(length == 0, "empty ring buffer returned a readable region");
+    VerifyOrQuit(readPointer == storage, "empty ring buffer read pointer is wrong");
+
+    writePointer = ringBuffer.GetWritePointer(length);
+    VerifyOrQuit(length == kBufferSize, "empty ring buffer write region is not the whole storage");
+    VerifyOrQuit(writePointer == storage, "empty ring buffer write pointer is wrong");
+
+    printf("TestRingBufferEmpty PASSED\n");
+}
+
+void TestRingBufferFull(void)
+{
+    uint8_t    storage[kBufferSize];
+    uint8_t    data[kBufferSize + 8];
+    uint8_t    out[kBufferSize];
+    RingBuffer ringBuffer;
+    uint16_t   length;
+
+    for (uint16_t i = 0; i < sizeof(data); i++)
+    {
+        data[i] = static_cast<uint8_t>(i);
+    }
+
+    ringBuffer.Init(storage, sizeof(storage));
+
+    VerifyOrQuit(WriteBytes(ringBuffer, data, sizeof(data)) == kBufferSize, "write did not stop when full");
+    VerifyOrQuit(!ringBuffer.IsEmpty(), "full ring buffer is empty");
+    VerifyOrQuit(ringBuffer.GetLength() == kBufferSize, "full ring buffer length is wrong");
+    VerifyOrQuit(ringBuffer.GetFreeSpace() == 0, "full ring buffer has free space");
+
+    ringBuffer.GetWritePointer(length);
+    VerifyOrQuit(length == 0, "full ring buffer returned a writable region");
+
+    VerifyOrQuit(ReadBytes(ringBuffer, out, sizeof(out)) == kBufferSize, "read of full ring buffer is short");
+    VerifyOrQuit(memcmp(out, data, sizeof(out)) == 0, "full ring buffer content is wrong");
+    VerifyOrQuit(ringBuffer.IsEmpty(), "drained ring buffer is not empty");
+
+    // Fill again after wrapping the positions to the end of the storage.
+    VerifyOrQuit(WriteBytes(ringBuffer, data, kBufferSize) == kBufferSize, "refill is short");
+    VerifyOrQuit(ringBuffer.GetFreeSpace() == 0, "refilled ring buffer has free space");
+
+    ringBuffer.Clear();
+    VerifyOrQuit(ringBuffer.IsEmpty(), "cleared ring buffer is not empty");
+    VerifyOrQuit(ringBuffer.GetFreeSpace() == kBufferSize, "cleared ring buffer free space is wrong");
+
+    printf("TestRingBufferFull PASSED\n");
+}
+
+void TestRingBufferWrapAround(void)
+{
+    uint8_t        storage[kBufferSize];
+    uint8_t        data[kBufferSize];
+    uint8_t        out[kBufferSize];
+    RingBuffer     ringBuffer;
+    uint16_t       length;
+    const uint8_t *readPointer;
+    uint8_t *      writePointer;
+
+    for (uint16_t i = 0; i < sizeof(data); i++)
+    {
+        data[i] = static_cast<uint8_t>(0xa0 + i);
+    }
+
+    ringBuffer.Init(storage, sizeof(storage));
+
+    // Move both positions to 48 bytes into the storage.
+    VerifyOrQuit(WriteBytes(ringBuffer, data, 48) == 48, "initial write is short");
+    VerifyOrQuit(ReadBytes(ringBuffer, out, 48) == 48, "initial read is short");
+    VerifyOrQuit(ringBuffer.IsEmpty(), "ring buffer is not empty");
+
+    // The free space wraps, so the first write region ends at the end of the storage.
+    writePointer = ringBuffer.GetWritePointer(length);
+    VerifyOrQuit(writePointer == storage + 48, "write pointer before wrap is wrong");
+    VerifyOrQuit(length == kBufferSize - 48, "write region before wrap is not truncated at the end");
+
+    VerifyOrQuit(WriteBytes(ringBuffer, data, 40) == 40, "wrapping write is short");
+    VerifyOrQuit(ringBuffer.GetLength() == 40, "length after wrapping write is wrong");
+    VerifyOrQuit(memcmp(storage + 48, data, 16) == 0, "bytes before wrap are wrong");
+    VerifyOrQuit(memcmp(storage, data + 16, 24) == 0, "bytes after wrap are wrong");
+
+    // The stored bytes wrap, so the first read region ends at the end of the storage.
+    readPointer = ringBuffer.GetReadPointer(length);
+    VerifyOrQuit(readPointer == storage + 48, "read pointer before wrap is wrong");
+    VerifyOrQuit(length == 16, "read region before wrap is not truncated at the end");
+
+    ringBuffer.CommitRead(length);
+    readPointer = ringBuffer.GetReadPointer(length);
+    VerifyOrQuit(readPointer == storage, "read pointer after wrap is wrong");
+    VerifyOrQuit(length == 24, "read region after wrap is wrong");
+    VerifyOrQuit(memcmp(readPointer, data + 16, 24) == 0, "read bytes after wrap are wrong");
+    ringBuffer.CommitRead(length);
+    VerifyOrQuit(ringBuffer.IsEmpty(), "ring buffer is not empty after wrap");
+
+    // Run the free running positions through their 16-bit overflow.
+    for (uint32_t i = 0; i < 0x20000; i += 40)
+    {
+        VerifyOrQuit(WriteBytes(ringBuffer, data, 40) == 40, "write while cycling is short");
+        VerifyOrQuit(ringBuffer.GetLength() == 40, "length while cycling is wrong");
+        VerifyOrQuit(ringBuffer.GetFreeSpace() == kBufferSize - 40, "free space while cycling is wrong");
+        VerifyOrQuit(ReadBytes(ringBuffer, out, 40) == 40, "read while cycling is short");
+        VerifyOrQuit(memcmp(out, data, 40) == 0, "bytes while cycling are wrong");
+    }
+
+    printf("TestRingBufferWrapAround PASSED\n");
+}
+
+void TestRingBufferPartial(void)
+{
+    uint8_t        storage[kBufferSize];
+    uint8_t        data[kBufferSize];
+    RingBuffer     ringBuffer;
+    uint16_t       length;
+    const uint8_t *readPointer;
+    uint8_t *      writePointer;
+
+    for (uint16_t i = 0; i < sizeof(data); i++)
+    {
+        data[i] = static_cast<uint8_t>(0x30 + i);
+    }
+
+    ringBuffer.Init(storage, sizeof(storage));
+
+    // Commit less than the offered write region, as a short UART read does.
+    writePointer = ringBuffer.GetWritePointer(length);
+    VerifyOrQuit(length == kBufferSize, "write region is wrong");
+    memcpy(writePointer, data, 10);
+    ringBuffer.CommitWrite(10);
+
+    writePointer = ringBuffer.GetWritePointer(length);
+    VerifyOrQuit(writePointer == storage + 10, "write pointer after partial write is wrong");
+    VerifyOrQuit(length == kBufferSize - 10, "write region after partial write is wrong");
+    memcpy(writePointer, data + 10, 5);
+    ringBuffer.CommitWrite(5);
+    VerifyOrQuit(ringBuffer.GetLength() == 15, "length after partial writes is wrong");
+
+    // Consume less than the offered read region, as a decoder stopping at a frame boundary does.
+    readPointer = ringBuffer.GetReadPointer(length);
+    VerifyOrQuit(length == 15, "read region is wrong");
+    VerifyOrQuit(memcmp(readPointer, data, 15) == 0, "read bytes are wrong");
+    ringBuffer.CommitRead(7);
+
+    readPointer = ringBuffer.GetReadPointer(length);
+    VerifyOrQuit(readPointer == storage + 7, "read pointer after partial read is wrong");
+    VerifyOrQuit(length == 8, "read region after partial read is wrong");
+    VerifyOrQuit(memcmp(readPointer, data + 7, 8) == 0, "bytes after partial read are wrong");
+
+    // Interleave odd sized writes and reads over several wraps and check the byte stream stays in order.
+    ringBuffer.Clear();
+
+    {
+        uint8_t  expected = 0;
+        uint8_t  next     = 0;
+        uint16_t sizes[]  = {1, 3, 7, 13, 31, 5, 17, 2};
+
+        for (uint16_t round = 0; round < 200; round++)
+        {
+            uint16_t writeSize = sizes[round % (sizeof(sizes) / sizeof(sizes[0]))];
+            uint16_t readSize  = sizes[(round + 3) % (sizeof(sizes) / sizeof(sizes[0]))];
+
+            writePointer = ringBuffer.GetWritePointer(length);
+
+            if (length > writeSize)
+            {
+                length = writeSize;
+            }
+
+            for (uint16_t i = 0; i < length; i++)
+            {
+                writePointer[i] = next++;
+            }
+
+            ringBuffer.CommitWrite(length);
+
+            readPointer = ringBuffer.GetReadPointer(length);
+
+            if (length > readSize)
+            {
+                length = readSize;
+            }
+
+            for (uint16_t i = 0; i < length; i++)
+            {
+                VerifyOrQuit(readPointer[i] == expected++, "byte stream out of order");
+            }
+
+            ringBuffer.CommitRead(length);
+        }
+    }
+
+    printf("TestRingBufferPartial PASSED\n");
+}
+
+int main(void)
+{
+    TestRingBufferEmpty();
+    TestRingBufferFull();
+    TestRingBufferWrapAround();
+    TestRingBufferPartial();
+    printf("All tests passed\n");
+    return 0;
+}
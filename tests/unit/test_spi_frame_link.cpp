@@ -0,0 +1,380 @@
+/*
+ *  Copyright (c) 2020, The OpenThread Authors.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  3. Neither the name of the copyright holder nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <vector>
+
+#include "spi_frame_link.hpp"
+#include "test_util.h"
+
+using ot::Esp32::SpiFrameLink;
+
+enum
+{
+    kAlignAllowance  = 4,
+    kSmallPacketSize = 32,
+    kMaxFrameSize    = 1300,
+    kBufferSize      = kAlignAllowance + SpiFrameLink::kHeaderSize + kMaxFrameSize,
+};
+
+/**
+ * This class emulates the RCP side of the spinel SPI link.
+ *
+ */
+class StubRcp
+{
+public:
+    enum Mode
+    {
+        kModeNotReadyHigh, ///< The RCP does not drive MISO, 0xff is clocked.
+        kModeNotReadyLow,  ///< The RCP is held in reset, 0x00 is clocked.
+        kModeReady,
+    };
+
+    StubRcp(void)
+        : mMode(kModeReady)
+        , mAlignBytes(0)
+        , mAcceptLength(kMaxFrameSize)
+        , mResetFlag(false)
+    {
+    }
+
+    // Performs one full duplex transfer of `aLength` bytes.
+    void Transfer(const uint8_t *aMosi, uint8_t *aMiso, uint16_t aLength)
+    {
+        uint8_t  flags;
+        uint16_t masterAcceptLength;
+        uint16_t masterDataLength;
+        uint16_t dataLength = mTxFrames.empty() ? 0 : static_cast<uint16_t>(mTxFrames.front().size());
+        uint8_t *header     = aMiso + mAlignBytes;
+
+        if (mMode != kModeReady)
+        {
+            memset(aMiso, (mMode == kModeNotReadyHigh) ? 0xff : 0x00, aLength);
+            return;
+        }
+
+        VerifyOrQuit(aLength >= mAlignBytes + SpiFrameLink::kHeaderSize, "transaction shorter than the header");
+        SuccessOrQuit(SpiFrameLink::ParseHeader(aMosi, flags, masterAcceptLength, masterDataLength),
+                      "invalid master header");
+        mMasterFlags.push_back(flags);
+
+        memset(aMiso, 0xff, aLength);
+        SpiFrameLink::WriteHeader(header, SpiFrameLink::kFlagPattern | (mResetFlag ? SpiFrameLink::kFlagReset : 0),
+                                  mAcceptLength, dataLength);
+        mResetFlag = false;
+
+        // The frame is transferred only if the other side accepts all of it and it is clocked completely.
+        if (dataLength > 0 && dataLength <= masterAcceptLength &&
+            mAlignBytes + SpiFrameLink::kHeaderSize + dataLength <= aLength)
+        {
+            memcpy(header + SpiFrameLink::kHeaderSize, mTxFrames.front().data(), dataLength);
+            mTxFrames.erase(mTxFrames.begin());
+        }
+
+        if (masterDataLength > 0 && masterDataLength <= mAcceptLength)
+        {
+            VerifyOrQuit(SpiFrameLink::kHeaderSize + masterDataLength <= aLength, "master frame is not clocked");
+            mRxFrames.push_back(std::vector<uint8_t>(aMosi + SpiFrameLink::kHeaderSize,
+                                                     aMosi + SpiFrameLink::kHeaderSize + masterDataLength));
+        }
+    }
+
+    Mode                              mMode;
+    uint16_t                          mAlignBytes;
+    uint16_t                          mAcceptLength;
+    bool                              mResetFlag;
+    std::vector<std::vector<uint8_t>> mTxFrames;
+    std::vector<std::vector<uint8_t>> mRxFrames;
+    std::vector<uint8_t>              mMasterFlags;
+};
+
+/**
+ * This class drives a `SpiFrameLink` against a `StubRcp` the way `SpiInterface` does.
+ *
+ */
+class Host
+{
+public:
+    Host(void)
+        : mLink(kAlignAllowance, kSmallPacketSize, kMaxFrameSize)
+        , mResets(0)
+        , mTxDone(0)
+        , mDropped(0)
+    {
+    }
+
+    void QueueFrame(const std::vector<uint8_t> &aFrame)
+    {
+        VerifyOrQuit(!mLink.IsTxPending(), "queueing over a pending frame");
+        memcpy(mTxBuffer + SpiFrameLink::kHeaderSize, aFrame.data(), aFrame.size());
+        mLink.QueueFrame(static_cast<uint16_t>(aFrame.size()));
+    }
+
+    otError PushPull(StubRcp &aRcp)
+    {
+        otError              error;
+        uint16_t             length = mLink.PrepareTransaction(mTxBuffer);
+        SpiFrameLink::Result result;
+
+        VerifyOrQuit(length <= kBufferSize, "transaction larger than the transfer buffers");
+        aRcp.Transfer(mTxBuffer, mRxBuffer, length);
+        error = mLink.HandleTransaction(mRxBuffer, result);
+
+        mResets += result.mSlaveReset ? 1 : 0;
+        mTxDone += result.mTxDone ? 1 : 0;
+        mDropped += result.mRxDropped ? 1 : 0;
+
+        if (result.mRxFrame != NULL)
+        {
+            mRxFrames.push_back(std::vector<uint8_t>(result.mRxFrame, result.mRxFrame + result.mRxFrameLength));
+        }
+
+        return error;
+    }
+
+    SpiFrameLink                      mLink;
+    uint8_t                           mTxBuffer[kBufferSize];
+    uint8_t                           mRxBuffer[kBufferSize];
+    uint32_t                          mResets;
+    uint32_t                          mTxDone;
+    uint32_t                          mDropped;
+    std::vector<std::vector<uint8_t>> mRxFrames;
+};
+
+static std::vector<uint8_t> MakeFrame(uint16_t aLength, uint8_t aSeed)
+{
+    std::vector<uint8_t> frame(aLength);
+
+    for (uint16_t i = 0; i < aLength; i++)
+    {
+        frame[i] = static_cast<uint8_t>(aSeed + i * 7);
+    }
+
+    return frame;
+}
+
+void TestSpiHeader(void)
+{
+    uint8_t  buffer[SpiFrameLink::kHeaderSize];
+    uint8_t  flags;
+    uint16_t acceptLength;
+    uint16_t dataLength;
+
+    SpiFrameLink::WriteHeader(buffer, SpiFrameLink::kFlagPattern | SpiFrameLink::kFlagReset, 0x1234, 0x0567);
+    VerifyOrQuit(buffer[0] == 0x82, "flag byte is wrong");
+    VerifyOrQuit(buffer[1] == 0x34 && buffer[2] == 0x12, "accept length is not little endian");
+    VerifyOrQuit(buffer[3] == 0x67 && buffer[4] == 0x05, "data length is not little endian");
+
+    SuccessOrQuit(SpiFrameLink::ParseHeader(buffer, flags, acceptLength, dataLength), "ParseHeader() failed");
+    VerifyOrQuit(flags == 0x82 && acceptLength == 0x1234 && dataLength == 0x0567, "parsed header is wrong");
+
+    buffer[0] = 0xff;
+    VerifyOrQuit(SpiFrameLink::ParseHeader(buffer, flags, acceptLength, dataLength) == OT_ERROR_PARSE,
+                 "0xff flag byte was accepted");
+    buffer[0] = 0x00;
+    VerifyOrQuit(SpiFrameLink::ParseHeader(buffer, flags, acceptLength, dataLength) == OT_ERROR_PARSE,
+                 "0x00 flag byte was accepted");
+    buffer[0] = 0x01;
+    VerifyOrQuit(SpiFrameLink::ParseHeader(buffer, flags, acceptLength, dataLength) == OT_ERROR_PARSE,
+                 "wrong pattern was accepted");
+
+    printf("TestSpiHeader PASSED\n");
+}
+
+void TestSpiNotReady(void)
+{
+    Host                 host;
+    StubRcp              rcp;
+    std::vector<uint8_t> frame = MakeFrame(10, 1);
+
+    host.QueueFrame(frame);
+
+    // Neither an idle nor a reset RCP produces a valid header, the frame stays pending and the reset flag is kept.
+    rcp.mMode = StubRcp::kModeNotReadyHigh;
+    VerifyOrQuit(host.PushPull(rcp) == OT_ERROR_PARSE, "idle RCP was not reported");
+    rcp.mMode = StubRcp::kModeNotReadyLow;
+    VerifyOrQuit(host.PushPull(rcp) == OT_ERROR_PARSE, "RCP in reset was not reported");
+    VerifyOrQuit(host.mLink.IsTxPending(), "frame was dropped while the RCP was not ready");
+    VerifyOrQuit(host.mTxBuffer[0] & SpiFrameLink::kFlagReset, "reset flag was cleared without a valid header");
+
+    rcp.mMode = StubRcp::kModeReady;
+    SuccessOrQuit(host.PushPull(rcp), "transaction with the ready RCP failed");
+    VerifyOrQuit(!host.mLink.IsTxPending() && host.mTxDone == 1, "frame was not sent once the RCP was ready");
+    VerifyOrQuit(rcp.mRxFrames.size() == 1 && rcp.mRxFrames[0] == frame, "RCP received a wrong frame");
+
+    // The reset flag is announced until the first valid header, then cleared.
+    SuccessOrQuit(host.PushPull(rcp), "poll failed");
+    VerifyOrQuit(rcp.mMasterFlags.size() == 2, "unexpected number of valid transactions");
+    VerifyOrQuit(rcp.mMasterFlags[0] & SpiFrameLink::kFlagReset, "first header did not announce the reset");
+    VerifyOrQuit(!(rcp.mMasterFlags[1] & SpiFrameLink::kFlagReset), "reset flag was not cleared");
+
+    printf("TestSpiNotReady PASSED\n");
+}
+
+void TestSpiRetry(void)
+{
+    Host                 host;
+    StubRcp              rcp;
+    std::vector<uint8_t> frame = MakeFrame(100, 2);
+
+    host.QueueFrame(frame);
+
+    // The RCP cannot take the frame yet, it is offered again in every transaction.
+    rcp.mAcceptLength = 50;
+
+    for (uint8_t i = 0; i < 3; i++)
+    {
+        SuccessOrQuit(host.PushPull(rcp), "transaction failed");
+        VerifyOrQuit(host.mLink.IsTxPending(), "frame was considered sent although the RCP did not accept it");
+    }
+
+    VerifyOrQuit(rcp.mRxFrames.empty(), "RCP received a frame it did not accept");
+
+    rcp.mAcceptLength = kMaxFrameSize;
+    SuccessOrQuit(host.PushPull(rcp), "retry failed");
+    VerifyOrQuit(!host.mLink.IsTxPending() && host.mTxDone == 1, "retried frame was not sent");
+    VerifyOrQuit(rcp.mRxFrames.size() == 1 && rcp.mRxFrames[0] == frame, "RCP received a wrong frame");
+
+    printf("TestSpiRetry PASSED\n");
+}
+
+void TestSpiReceive(void)
+{
+    Host                 host;
+    StubRcp              rcp;
+    std::vector<uint8_t> small = MakeFrame(kSmallPacketSize, 3);
+    std::vector<uint8_t> large = MakeFrame(kMaxFrameSize, 4);
+    std::vector<uint8_t> sent  = MakeFrame(200, 5);
+
+    // A small frame is received in the polling transaction.
+    rcp.mTxFrames.push_back(small);
+    SuccessOrQuit(host.PushPull(rcp), "small frame transaction failed");
+    VerifyOrQuit(host.mRxFrames.size() == 1 && host.mRxFrames[0] == small, "small frame was not received");
+    VerifyOrQuit(!host.mLink.IsRxPending(), "small frame is still pending");
+
+    // A larger frame is announced by the polling transaction and clocked by the next one.
+    rcp.mTxFrames.push_back(large);
+    SuccessOrQuit(host.PushPull(rcp), "large frame announcement failed");
+    VerifyOrQuit(host.mRxFrames.size() == 1, "large frame was received from a short transaction");
+    VerifyOrQuit(host.mLink.IsRxPending(), "large frame is not pending");
+    SuccessOrQuit(host.PushPull(rcp), "large frame transaction failed");
+    VerifyOrQuit(host.mRxFrames.size() == 2 && host.mRxFrames[1] == large, "large frame was not received");
+    VerifyOrQuit(!host.mLink.IsRxPending(), "large frame is still pending");
+
+    // Frames in both directions in the same transaction.
+    rcp.mTxFrames.push_back(MakeFrame(150, 6));
+    host.QueueFrame(sent);
+    SuccessOrQuit(host.PushPull(rcp), "full duplex transaction failed");
+    VerifyOrQuit(host.mRxFrames.size() == 3 && host.mRxFrames[2] == MakeFrame(150, 6), "full duplex rx failed");
+    VerifyOrQuit(rcp.mRxFrames.size() == 1 && rcp.mRxFrames[0] == sent, "full duplex tx failed");
+
+    printf("TestSpiReceive PASSED\n");
+}
+
+void TestSpiAlignAllowance(void)
+{
+    for (uint16_t alignBytes = 0; alignBytes <= kAlignAllowance; alignBytes++)
+    {
+        Host                 host;
+        StubRcp              rcp;
+        std::vector<uint8_t> frame = MakeFrame(20, static_cast<uint8_t>(alignBytes));
+
+        rcp.mAlignBytes = alignBytes;
+        rcp.mTxFrames.push_back(frame);
+        SuccessOrQuit(host.PushPull(rcp), "header after align bytes was not found");
+        VerifyOrQuit(host.mRxFrames.size() == 1 && host.mRxFrames[0] == frame, "frame after align bytes is wrong");
+    }
+
+    printf("TestSpiAlignAllowance PASSED\n");
+}
+
+void TestSpiSlaveReset(void)
+{
+    Host    host;
+    StubRcp rcp;
+
+    SuccessOrQuit(host.PushPull(rcp), "transaction failed");
+    VerifyOrQuit(host.mResets == 0, "reset reported without the reset flag");
+
+    rcp.mResetFlag = true;
+    SuccessOrQuit(host.PushPull(rcp), "transaction failed");
+    VerifyOrQuit(host.mResets == 1, "RCP reset was not reported");
+
+    SuccessOrQuit(host.PushPull(rcp), "transaction failed");
+    VerifyOrQuit(host.mResets == 1, "RCP reset was reported twice");
+
+    // A host reset drops the pending frame and is announced again.
+    host.QueueFrame(MakeFrame(10, 7));
+    rcp.mAcceptLength = 0;
+    SuccessOrQuit(host.PushPull(rcp), "transaction failed");
+    host.mLink.Reset();
+    VerifyOrQuit(!host.mLink.IsTxPending(), "Reset() kept the pending frame");
+    host.mLink.PrepareTransaction(host.mTxBuffer);
+    VerifyOrQuit(host.mTxBuffer[0] & SpiFrameLink::kFlagReset, "Reset() is not announced");
+
+    printf("TestSpiSlaveReset PASSED\n");
+}
+
+void TestSpiOversizedFrame(void)
+{
+    Host    host;
+    uint8_t header[SpiFrameLink::kHeaderSize];
+
+    // An RCP announcing more than the maximum frame size is not followed.
+    SpiFrameLink::WriteHeader(header, SpiFrameLink::kFlagPattern, kMaxFrameSize, kMaxFrameSize + 1);
+    host.mLink.PrepareTransaction(host.mTxBuffer);
+    memset(host.mRxBuffer, 0xff, sizeof(host.mRxBuffer));
+    memcpy(host.mRxBuffer, header, sizeof(header));
+
+    {
+        SpiFrameLink::Result result;
+
+        VerifyOrQuit(host.mLink.HandleTransaction(host.mRxBuffer, result) == OT_ERROR_PARSE,
+                     "oversized frame was not rejected");
+        VerifyOrQuit(result.mRxDropped && result.mRxFrame == NULL, "oversized frame was not dropped");
+        VerifyOrQuit(!host.mLink.IsRxPending(), "oversized frame is pending");
+    }
+
+    printf("TestSpiOversizedFrame PASSED\n");
+}
+
+int main(void)
+{
+    TestSpiHeader();
+    TestSpiNotReady();
+    TestSpiRetry();
+    TestSpiReceive();
+    TestSpiAlignAllowance();
+    TestSpiSlaveReset();
+    TestSpiOversizedFrame();
+    printf("All tests passed\n");
+    return 0;
+}
@@ -0,0 +1,436 @@
+/*
+ *  Copyright (c) 2020, The OpenThread Authors.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  3. Neither the name of the copyright holder nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <poll.h>
+#include <pty.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <termios.h>
+#include <unistd.h>
+#include <vector>
+
+#include <openthread/platform/time.h>
+
+#include "platform-esp32.h"
+#include "rcp_simulator.hpp"
+#include "spinel_hdlc.hpp"
+#include "test_util.h"
+#include "common/code_utils.hpp"
+#include "lib/spinel/spinel.h"
+
+using ot::Esp32::HdlcInterface;
+using ot::Esp32::HdlcUartConfig;
+
+enum
+{
+    kHostPort          = UART_NUM_1,
+    kDefaultBaudRate   = 115200,
+    kFastBaudRate      = 921600,
+    kResponseTimeout   = 100000, ///< Microseconds.
+    kLatencyIterations = 200,
+    kTransmitFrames    = 200,
+    kMaxPsduSize       = 127,
+    kRxFrameRate       = 500, ///< Frames per second.
+    kRxDuration        = 1000, ///< Milliseconds.
+    kMaxFrameSize      = ot::Spinel::SpinelInterface::kMaxFrameSize,
+};
+
+/**
+ * This structure records the frames passed up by the HDLC interface, like `RadioSpinel` would handle them.
+ *
+ */
+struct FrameReceiver
+{
+    FrameReceiver(void)
+        : mFrames(0)
+        , mBytes(0)
+    {
+    }
+
+    static void HandleReceivedFrame(void *aContext)
+    {
+        FrameReceiver &receiver = *static_cast<FrameReceiver *>(aContext);
+        const uint8_t *frame    = receiver.mBuffer.GetFrame();
+
+        receiver.mLastFrame.assign(frame, frame + receiver.mBuffer.GetLength());
+        receiver.mFrames++;
+        receiver.mBytes += receiver.mBuffer.GetLength();
+        receiver.mBuffer.DiscardFrame();
+    }
+
+    ot::Spinel::SpinelInterface::RxFrameBuffer mBuffer;
+    std::vector<uint8_t>                       mLastFrame;
+    uint32_t                                   mFrames;
+    uint64_t                                   mBytes;
+};
+
+/**
+ * This class connects an HDLC interface to a simulated RCP through a pseudo terminal.
+ *
+ */
+class TestLink
+{
+public:
+    TestLink(void)
+        : mMasterFd(-1)
+        , mSlaveFd(-1)
+        , mInterface(FrameReceiver::HandleReceivedFrame, &mReceiver, mReceiver.mBuffer)
+        , mSimulator(OpenPty(), static_cast<uart_port_t>(kHostPort), kDefaultBaudRate)
+    {
+        HdlcUartConfig config = {static_cast<uart_port_t>(kHostPort),
+                                 UART_PIN_NO_CHANGE,
+                                 UART_PIN_NO_CHANGE,
+                                 UART_PIN_NO_CHANGE,
+                                 UART_PIN_NO_CHANGE,
+                                 UART_HW_FLOWCTRL_DISABLE,
+                                 kDefaultBaudRate,
+                                 OT_EVENT_RADIO_UART};
+
+        HostUartAttach(static_cast<uart_port_t>(kHostPort), mSlaveFd);
+        mInterface.Init(config);
+        mSimulator.Start();
+    }
+
+    ~TestLink(void)
+    {
+        mSimulator.Stop();
+        mInterface.Deinit();
+        HostUartSetTxStalled(static_cast<uart_port_t>(kHostPort), false);
+        close(mSlaveFd);
+        close(mMasterFd);
+    }
+
+    /**
+     * This method sends a spinel frame and waits for the next frame from the RCP.
+     *
+     */
+    otError Transact(const uint8_t *aFrame, uint16_t aLength)
+    {
+        otError  error  = OT_ERROR_NONE;
+        uint32_t frames = mReceiver.mFrames;
+        uint64_t end;
+
+        SuccessOrExit(error = mInterface.SendFrame(aFrame, aLength));
+        end = otPlatTimeGet() + kResponseTimeout;
+
+        while (mReceiver.mFrames == frames)
+        {
+            uint64_t now = otPlatTimeGet();
+
+            VerifyOrExit(now < end, error = OT_ERROR_RESPONSE_TIMEOUT);
+            mInterface.WaitForFrame(end - now);
+        }
+
+    exit:
+        return error;
+    }
+
+    /**
+     * This method gets a property and waits for its value.
+     *
+     */
+    otError GetProperty(spinel_prop_key_t aKey, uint8_t aTid)
+    {
+        uint8_t        frame[8];
+        spinel_ssize_t length = spinel_datatype_pack(frame, sizeof(frame), SPINEL_DATATYPE_COMMAND_PROP_S,
+                                                     SPINEL_HEADER_FLAG | SPINEL_HEADER_IID_0 | aTid,
+                                                     SPINEL_CMD_PROP_VALUE_GET, aKey);
+
+        return Transact(frame, static_cast<uint16_t>(length));
+    }
+
+    /**
+     * This method runs the mainloop around the HDLC interface for a while.
+     *
+     */
+    void RunMainloop(uint32_t aDurationMs)
+    {
+        uint64_t end = otPlatTimeGet() + static_cast<uint64_t>(aDurationMs) * OT_US_PER_MS;
+
+        while (otPlatTimeGet() < end)
+        {
+            otSysMainloopContext mainloop;
+            struct pollfd        pollFd = {mSlaveFd, POLLIN, 0};
+            int                  timeout;
+
+            memset(&mainloop, 0, sizeof(mainloop));
+            mainloop.mTimeout.tv_usec = OT_US_PER_MS;
+            mInterface.Update(mainloop);
+            timeout = static_cast<int>(mainloop.mTimeout.tv_sec * OT_MS_PER_S + mainloop.mTimeout.tv_usec / OT_US_PER_MS);
+            poll(&pollFd, 1, timeout);
+            mInterface.Process(mainloop);
+        }
+    }
+
+    int            mMasterFd;
+    int            mSlaveFd;
+    FrameReceiver  mReceiver;
+    HdlcInterface  mInterface;
+    RcpSimulator   mSimulator;
+
+private:
+    int OpenPty(void)
+    {
+        struct termios attributes;
+
+        VerifyOrQuit(openpty(&mMasterFd, &mSlaveFd, NULL, NULL, NULL) == 0, "openpty() failed");
+        VerifyOrQuit(tcgetattr(mSlaveFd, &attributes) == 0, "tcgetattr() failed");
+        cfmakeraw(&attributes);
+        VerifyOrQuit(tcsetattr(mSlaveFd, TCSANOW, &attributes) == 0, "tcsetattr() failed");
+
+        return mMasterFd;
+    }
+};
+
+static bool IsPropertyIs(const std::vector<uint8_t> &aFrame, spinel_prop_key_t aKey)
+{
+    uint8_t        header;
+    unsigned int   command;
+    unsigned int   key;
+    spinel_ssize_t unpacked;
+
+    unpacked = spinel_datatype_unpack(aFrame.data(), static_cast<spinel_size_t>(aFrame.size()),
+                                      SPINEL_DATATYPE_COMMAND_PROP_S, &header, &command, &key);
+
+    return unpacked > 0 && command == SPINEL_CMD_PROP_VALUE_IS && key == aKey;
+}
+
+static uint32_t GetLatencyCount(const otSysRcpLinkStats &aStats)
+{
+    uint32_t count = 0;
+
+    for (uint32_t bucketCount : aStats.mLatencyHistogram)
+    {
+        count += bucketCount;
+    }
+
+    return count;
+}
+
+void TestRequestLatency(void)
+{
+    TestLink link;
+    uint64_t maxLatency = 0;
+    uint64_t start      = otPlatTimeGet();
+
+    for (uint16_t i = 0; i < kLatencyIterations; i++)
+    {
+        uint64_t requestStart = otPlatTimeGet();
+        uint64_t latency;
+
+        SuccessOrQuit(link.GetProperty(SPINEL_PROP_PROTOCOL_VERSION, static_cast<uint8_t>(1 + i % 14)),
+                      "get property failed");
+        latency = otPlatTimeGet() - requestStart;
+
+        VerifyOrQuit(IsPropertyIs(link.mReceiver.mLastFrame, SPINEL_PROP_PROTOCOL_VERSION), "unexpected response");
+        maxLatency = latency > maxLatency ? latency : maxLatency;
+    }
+
+    VerifyOrQuit(GetLatencyCount(link.mInterface.GetLinkStats()) == kLatencyIterations,
+                 "latency histogram misses responses");
+    VerifyOrQuit(link.mInterface.GetHdlcResyncs() == 0, "link lost frames");
+
+    printf("TestRequestLatency %u requests at %u baud, %.0f us average, %llu us max\n", kLatencyIterations,
+           kDefaultBaudRate, static_cast<double>(otPlatTimeGet() - start) / kLatencyIterations,
+           static_cast<unsigned long long>(maxLatency));
+    printf("TestRequestLatency PASSED\n");
+}
+
+void TestTransmitAck(void)
+{
+    TestLink link;
+    uint8_t  psdu[kMaxPsduSize];
+    uint8_t  frame[kMaxPsduSize + 16];
+    uint64_t start;
+    uint64_t duration;
+
+    SuccessOrQuit(link.mInterface.NegotiateBaudRate(kFastBaudRate), "baud rate negotiation failed");
+
+    for (uint16_t i = 0; i < sizeof(psdu); i++)
+    {
+        psdu[i] = static_cast<uint8_t>(i);
+    }
+
+    start = otPlatTimeGet();
+
+    for (uint16_t i = 0; i < kTransmitFrames; i++)
+    {
+        spinel_ssize_t length =
+            spinel_datatype_pack(frame, sizeof(frame), SPINEL_DATATYPE_COMMAND_PROP_S SPINEL_DATATYPE_DATA_WLEN_S,
+                                 SPINEL_HEADER_FLAG | SPINEL_HEADER_IID_0 | static_cast<uint8_t>(1 + i % 14),
+                                 SPINEL_CMD_PROP_VALUE_SET, SPINEL_PROP_STREAM_RAW, psdu, sizeof(psdu));
+
+        SuccessOrQuit(link.Transact(frame, static_cast<uint16_t>(length)), "transmit failed");
+        VerifyOrQuit(IsPropertyIs(link.mReceiver.mLastFrame, SPINEL_PROP_LAST_STATUS), "transmit not acknowledged");
+    }
+
+    duration = otPlatTimeGet() - start;
+
+    VerifyOrQuit(link.mSimulator.GetTransmitCount() == kTransmitFrames, "RCP missed transmit requests");
+    VerifyOrQuit(link.mInterface.GetHdlcResyncs() == 0, "link lost frames");
+
+    printf("TestTransmitAck %u frames of %u bytes at %u baud, %.0f frames/s\n", kTransmitFrames, kMaxPsduSize,
+           kFastBaudRate, kTransmitFrames * static_cast<double>(OT_US_PER_S) / duration);
+    printf("TestTransmitAck PASSED\n");
+}
+
+void TestReceiveThroughput(void)
+{
+    TestLink link;
+    uint32_t injected;
+    uint64_t start;
+    uint64_t duration;
+
+    SuccessOrQuit(link.mInterface.NegotiateBaudRate(kFastBaudRate), "baud rate negotiation failed");
+    link.mInterface.ResetLinkStats();
+
+    start = otPlatTimeGet();
+    link.mSimulator.SetRxFrameRate(kRxFrameRate, kMaxPsduSize);
+    link.RunMainloop(kRxDuration);
+    link.mSimulator.SetRxFrameRate(0, 0);
+    duration = otPlatTimeGet() - start;
+
+    // Whatever is still in flight.
+    link.RunMainloop(50);
+    injected = link.mSimulator.GetInjectedFrameCount();
+
+    VerifyOrQuit(injected > 0, "RCP injected no frame");
+    VerifyOrQuit(link.mSimulator.GetDroppedBytes() == 0, "host did not keep up with the link");
+    VerifyOrQuit(link.mReceiver.mFrames == injected, "received frames differ from injected frames");
+    VerifyOrQuit(link.mInterface.GetLinkStats().mRxFrames == injected, "link statistics miss frames");
+    VerifyOrQuit(link.mInterface.GetHdlcResyncs() == 0, "link lost frames");
+
+    printf("TestReceiveThroughput %u frames at %u baud, %.0f frames/s, %.0f bytes/s of spinel frames\n", injected,
+           kFastBaudRate, injected * static_cast<double>(OT_US_PER_S) / duration,
+           link.mReceiver.mBytes * static_cast<double>(OT_US_PER_S) / duration);
+    printf("TestReceiveThroughput PASSED\n");
+}
+
+void TestFlowControlStall(void)
+{
+    TestLink             link;
+    std::vector<uint8_t> value(kMaxFrameSize, 0x55);
+    std::vector<uint8_t> frame(value.size() + 16);
+    spinel_ssize_t       length;
+    uint64_t             start;
+
+    length = spinel_datatype_pack(frame.data(), static_cast<spinel_size_t>(frame.size()),
+                                  SPINEL_DATATYPE_COMMAND_PROP_S SPINEL_DATATYPE_DATA_S,
+                                  SPINEL_HEADER_FLAG | SPINEL_HEADER_IID_0 | 1, SPINEL_CMD_PROP_VALUE_SET,
+                                  SPINEL_PROP_VENDOR__BEGIN, value.data(), static_cast<spinel_size_t>(value.size()));
+
+    // The RCP holds CTS, and the frame takes more than the TX queue.
+    HostUartSetTxStalled(static_cast<uart_port_t>(kHostPort), true);
+
+    start = otPlatTimeGet();
+    SuccessOrQuit(link.mInterface.SendFrame(frame.data(), 16), "queuing a frame blocked on a stalled link");
+    VerifyOrQuit(otPlatTimeGet() - start < 100 * OT_US_PER_MS, "queuing a frame waited for the stalled link");
+    VerifyOrQuit(!link.mInterface.IsIdle(), "stalled link reported idle");
+
+    VerifyOrQuit(link.mInterface.SendFrame(frame.data(), static_cast<uint16_t>(length)) == OT_ERROR_FAILED,
+                 "sending on a stalled link did not fail");
+    VerifyOrQuit(link.mInterface.GetLinkStats().mWriteTimeouts == 1, "write timeout not counted");
+
+    // Once released, the link drains and keeps working, the truncated frame is dropped by the RCP.
+    HostUartSetTxStalled(static_cast<uart_port_t>(kHostPort), false);
+    link.RunMainloop(200);
+    VerifyOrQuit(link.mInterface.IsIdle(), "link did not drain");
+    SuccessOrQuit(link.GetProperty(SPINEL_PROP_PROTOCOL_VERSION, 2), "link did not recover from the stall");
+    VerifyOrQuit(IsPropertyIs(link.mReceiver.mLastFrame, SPINEL_PROP_PROTOCOL_VERSION), "unexpected response");
+
+    printf("TestFlowControlStall blocked for %llu ms\n",
+           static_cast<unsigned long long>(link.mInterface.GetLinkStats().mWriteBlockedTime / OT_US_PER_MS));
+    printf("TestFlowControlStall PASSED\n");
+}
+
+void TestBaudRateRecovery(void)
+{
+    TestLink link;
+    uint64_t start;
+
+    link.mSimulator.SetBaudRateSupported(false);
+    VerifyOrQuit(link.mInterface.NegotiateBaudRate(kFastBaudRate) == OT_ERROR_NOT_IMPLEMENTED,
+                 "unsupported baud rate change not reported");
+    VerifyOrQuit(HostUartGetBaudRate(static_cast<uart_port_t>(kHostPort)) == kDefaultBaudRate,
+                 "uart left the default baud rate");
+
+    link.mSimulator.SetBaudRateSupported(true);
+    SuccessOrQuit(link.mInterface.NegotiateBaudRate(kFastBaudRate), "baud rate negotiation failed");
+    // The RCP switches once its answer is out, which may be after the host has received it.
+    link.RunMainloop(1);
+    VerifyOrQuit(link.mSimulator.GetBaudRate() == kFastBaudRate, "RCP did not switch");
+    VerifyOrQuit(HostUartGetBaudRate(static_cast<uart_port_t>(kHostPort)) == kFastBaudRate, "uart did not switch");
+
+    // A hardware reset brings the RCP back at the default baud rate, its reset notification is garbled.
+    link.mSimulator.Reset();
+    link.RunMainloop(50);
+
+    start = otPlatTimeGet();
+    VerifyOrQuit(link.GetProperty(SPINEL_PROP_PROTOCOL_VERSION, 1) == OT_ERROR_RESPONSE_TIMEOUT,
+                 "RCP answered at the wrong baud rate");
+
+    // The timeout schedules the renegotiation, which runs from the mainloop.
+    while (HostUartGetBaudRate(static_cast<uart_port_t>(kHostPort)) != kFastBaudRate ||
+           link.mSimulator.GetBaudRate() != kFastBaudRate)
+    {
+        VerifyOrQuit(otPlatTimeGet() - start < OT_US_PER_S, "link not renegotiated");
+        link.RunMainloop(1);
+    }
+
+    SuccessOrQuit(link.GetProperty(SPINEL_PROP_PROTOCOL_VERSION, 2), "link did not recover from the reset");
+
+    printf("TestBaudRateRecovery recovered in %llu us, including a %u us response timeout\n",
+           static_cast<unsigned long long>(otPlatTimeGet() - start), kResponseTimeout);
+    printf("TestBaudRateRecovery PASSED\n");
+}
+
+void TestRcpReset(void)
+{
+    TestLink link;
+
+    link.mSimulator.Reset();
+    link.RunMainloop(50);
+
+    VerifyOrQuit(link.mInterface.GetRcpResetCount() == 1, "RCP reset not counted");
+    VerifyOrQuit(IsPropertyIs(link.mReceiver.mLastFrame, SPINEL_PROP_LAST_STATUS), "RCP reset not passed up");
+
+    printf("TestRcpReset PASSED\n");
+}
+
+int main(void)
+{
+    TestRequestLatency();
+    TestTransmitAck();
+    TestReceiveThroughput();
+    TestFlowControlStall();
+    TestBaudRateRecovery();
+    TestRcpReset();
+    printf("All tests passed\n");
+    return 0;
+}